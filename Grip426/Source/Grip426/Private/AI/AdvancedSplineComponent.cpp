@@ -39,3 +39,79 @@ UAdvancedSplineComponent::UAdvancedSplineComponent()
 		ActorName = actor->GetName();
 	}
 }
+
+/**
+* Get the distance along the spline nearest to a world location, optionally only
+* searching a range either side of a hint distance.
+*
+* A coarse sampling of the search range is made first, followed by a refinement
+* around the closest sample, halving the step size each iteration.
+***********************************************************************************/
+
+float UAdvancedSplineComponent::GetNearestDistance(const FVector& location, float hintDistance, float searchRange) const
+{
+	float length = GetSplineLength();
+
+	if (length <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	bool closedLoop = IsClosedLoop();
+	float startDistance = 0.0f;
+	float endDistance = length;
+
+	if (hintDistance >= 0.0f &&
+		searchRange > 0.0f &&
+		searchRange * 2.0f < length)
+	{
+		startDistance = hintDistance - searchRange;
+		endDistance = hintDistance + searchRange;
+
+		if (closedLoop == false)
+		{
+			startDistance = FMath::Max(startDistance, 0.0f);
+			endDistance = FMath::Min(endDistance, length);
+		}
+	}
+
+	auto wrap = [length, closedLoop] (float distance)
+	{
+		return (closedLoop == true) ? FMath::Fmod(distance + length, length) : FMath::Clamp(distance, 0.0f, length);
+	};
+
+	int32 numSamples = FMath::Max(16, FMath::CeilToInt((endDistance - startDistance) / 1000.0f));
+	float step = (endDistance - startDistance) / numSamples;
+	float bestDistance = startDistance;
+	float bestDistanceSquared = BIG_NUMBER;
+
+	for (int32 i = 0; i <= numSamples; i++)
+	{
+		float distance = startDistance + (i * step);
+		float distanceSquared = (GetLocationAtDistanceAlongSpline(wrap(distance), ESplineCoordinateSpace::World) - location).SizeSquared();
+
+		if (bestDistanceSquared > distanceSquared)
+		{
+			bestDistanceSquared = distanceSquared;
+			bestDistance = distance;
+		}
+	}
+
+	for (int32 i = 0; i < 8; i++)
+	{
+		step *= 0.5f;
+
+		for (float distance : { bestDistance - step, bestDistance + step })
+		{
+			float distanceSquared = (GetLocationAtDistanceAlongSpline(wrap(distance), ESplineCoordinateSpace::World) - location).SizeSquared();
+
+			if (bestDistanceSquared > distanceSquared)
+			{
+				bestDistanceSquared = distanceSquared;
+				bestDistance = distance;
+			}
+		}
+	}
+
+	return wrap(bestDistance);
+}
@@ -59,3 +59,61 @@ bool APursuitSplineActor::SynchronisePointData()
 {
 	return false;
 }
+
+/**
+* Allocate the extended data for a number of points, all arrays kept in step.
+***********************************************************************************/
+
+void APursuitSplineActor::AllocateExtendedPointData(int32 numPoints)
+{
+	PointExtendedData.Reset(numPoints);
+	PointExtendedData.AddDefaulted(numPoints);
+
+	PointColdData.Reset(numPoints);
+	PointColdData.AddDefaulted(numPoints);
+
+	// A single contiguous block for all of the environment samples, so that reading
+	// them along the spline streams straight through the cache.
+
+	EnvironmentDistances.Reset(numPoints * FPursuitPointExtendedData::NumDistances);
+	EnvironmentDistances.AddZeroed(numPoints * FPursuitPointExtendedData::NumDistances);
+}
+
+/**
+* Set the environment distances for an extended point from NumDistances samples in
+* centimeters.
+***********************************************************************************/
+
+void APursuitSplineActor::SetEnvironmentDistances(int32 point, const float* distances)
+{
+	uint16* to = EnvironmentDistances.GetData() + (point * FPursuitPointExtendedData::NumDistances);
+
+	for (int32 i = 0; i < FPursuitPointExtendedData::NumDistances; i++)
+	{
+		to[i] = (uint16)FMath::Clamp(FMath::RoundToInt(distances[i]), 0, FPursuitPointExtendedData::MaxEnvironmentDistance);
+	}
+}
+
+/**
+* Does an extended point reside over level ground?
+***********************************************************************************/
+
+bool APursuitSplineActor::IsLevelGround(int32 point) const
+{
+	const int32 n = FPursuitPointExtendedData::NumDistances;
+	int32 index = PointExtendedData[point].UseGroundIndex;
+
+	return (GetEnvironmentDistance(point, index) < 25.0f * 100.0f && index >= (n >> 1) - (n >> 4) && index <= (n >> 1) + (n >> 4));
+}
+
+/**
+* Does an extended point reside under level ceiling?
+***********************************************************************************/
+
+bool APursuitSplineActor::IsLevelCeiling(int32 point) const
+{
+	const int32 n = FPursuitPointExtendedData::NumDistances;
+	int32 index = PointExtendedData[point].UseGroundIndex;
+
+	return (GetEnvironmentDistance(point, index) < 25.0f * 100.0f && (index >= (n - (n >> 4)) || index <= (n >> 4)));
+}
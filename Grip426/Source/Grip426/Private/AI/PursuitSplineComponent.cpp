@@ -18,6 +18,7 @@
 #include "ai/pursuitsplineactor.h"
 #include "kismet/kismetmathlibrary.h"
 #include "kismet/kismetmateriallibrary.h"
+#include "algo/binarysearch.h"
 #include "system/mathhelpers.h"
 #include "gamemodes/playgamemode.h"
 
@@ -46,3 +47,279 @@ void UPursuitSplineMeshComponent::SetupSplineComponent(UPursuitSplineComponent*
 void UPursuitSplineMeshComponent::SetupMaterial(bool selected)
 {
 }
+
+/**
+* Build the optimum and minimum speed profiles for the spline.
+*
+* Lateral grip, acceleration and braking are in G, maximum speed in KPH. The corner
+* speeds are derived from the lateral curvature of the spline, then forward and
+* backward passes limit those speeds to what can be reached by accelerating out of
+* and braking into each corner. Any speeds authored in the point data are applied
+* at their control points and propagated by the same passes.
+***********************************************************************************/
+
+void UPursuitSplineComponent::BuildSpeedProfile(float lateralGrip, float acceleration, float braking, float maximumSpeed)
+{
+	OptimumSpeedProfile.Empty();
+	MinimumSpeedProfile.Empty();
+
+	float length = GetSplineLength();
+
+	if (length <= 0.0f ||
+		SpeedProfileSpacing <= 0.0f)
+	{
+		return;
+	}
+
+	bool closedLoop = IsClosedLoop();
+	int32 numSamples = FMath::CeilToInt(length / SpeedProfileSpacing) + ((closedLoop == true) ? 0 : 1);
+
+	// We work in cm/s throughout, converting back to KPH at the end.
+
+	const float gravity = 981.0f;
+	float maxSpeed = FMathEx::KilometersPerHourToCentimetersPerSecond(maximumSpeed);
+	float accelerationStep = 2.0f * acceleration * gravity * SpeedProfileSpacing;
+	float brakingStep = 2.0f * braking * gravity * SpeedProfileSpacing;
+	TArray<float> optimum;
+	TArray<float> minimum;
+
+	optimum.SetNumUninitialized(numSamples);
+	minimum.SetNumZeroed(numSamples);
+
+	for (int32 i = 0; i < numSamples; i++)
+	{
+		float curvature = GetLateralCurvatureAtDistance(FMath::Min(i * SpeedProfileSpacing, length), SpeedProfileSpacing);
+
+		optimum[i] = (curvature > KINDA_SMALL_NUMBER) ? FMath::Min(maxSpeed, FMath::Sqrt(lateralGrip * gravity / curvature)) : maxSpeed;
+	}
+
+	// Impose the authored speeds on the samples closest to their control points.
+
+	APursuitSplineActor* actor = Cast<APursuitSplineActor>(GetOwner());
+
+	if (actor != nullptr)
+	{
+		int32 numPoints = FMath::Min(actor->PointData.Num(), GetNumberOfSplinePoints());
+
+		for (int32 p = 0; p < numPoints; p++)
+		{
+			const FPursuitPointData& pointData = actor->PointData[p];
+			int32 i = FMath::RoundToInt(GetDistanceAlongSplineAtSplinePoint(p) / SpeedProfileSpacing);
+
+			i = (closedLoop == true) ? i % numSamples : FMath::Min(i, numSamples - 1);
+
+			if (pointData.OptimumSpeed > 0.0f)
+			{
+				optimum[i] = FMath::Min(optimum[i], FMathEx::KilometersPerHourToCentimetersPerSecond(pointData.OptimumSpeed));
+			}
+
+			if (pointData.MinimumSpeed > 0.0f)
+			{
+				minimum[i] = FMath::Max(minimum[i], FMathEx::KilometersPerHourToCentimetersPerSecond(pointData.MinimumSpeed));
+			}
+		}
+	}
+
+	// Forward pass for acceleration, v^2 = u^2 + 2as. Loops are run around twice so that
+	// the limits carry across the start line. The minimum speeds work the other way
+	// around, decaying under braking after their points.
+
+	int32 numSteps = (closedLoop == true) ? numSamples * 2 : numSamples;
+
+	for (int32 j = 1; j < numSteps; j++)
+	{
+		int32 i = j % numSamples;
+		int32 p = (j - 1) % numSamples;
+
+		optimum[i] = FMath::Min(optimum[i], FMath::Sqrt(FMath::Square(optimum[p]) + accelerationStep));
+		minimum[i] = FMath::Max(minimum[i], FMath::Sqrt(FMath::Max(FMath::Square(minimum[p]) - brakingStep, 0.0f)));
+	}
+
+	// Backward pass for braking into corners, and building up to minimum speeds.
+
+	for (int32 j = numSteps - 2; j >= 0; j--)
+	{
+		int32 i = j % numSamples;
+		int32 n = (j + 1) % numSamples;
+
+		optimum[i] = FMath::Min(optimum[i], FMath::Sqrt(FMath::Square(optimum[n]) + brakingStep));
+		minimum[i] = FMath::Max(minimum[i], FMath::Sqrt(FMath::Max(FMath::Square(minimum[n]) - accelerationStep, 0.0f)));
+	}
+
+	OptimumSpeedProfile.SetNumUninitialized(numSamples);
+	MinimumSpeedProfile.SetNumUninitialized(numSamples);
+
+	for (int32 i = 0; i < numSamples; i++)
+	{
+		OptimumSpeedProfile[i] = (optimum[i] >= maxSpeed) ? 0.0f : FMathEx::CentimetersPerSecondToKilometersPerHour(optimum[i]);
+		MinimumSpeedProfile[i] = FMathEx::CentimetersPerSecondToKilometersPerHour(minimum[i]);
+	}
+}
+
+/**
+* Get the lateral curvature of the spline at a distance along it, in 1 / cm.
+*
+* Vertical curvature is removed as crests and dips don't limit cornering speed.
+***********************************************************************************/
+
+float UPursuitSplineComponent::GetLateralCurvatureAtDistance(float distance, float sampleDistance) const
+{
+	float length = GetSplineLength();
+	float d0 = distance - sampleDistance;
+	float d1 = distance + sampleDistance;
+	float span = sampleDistance * 2.0f;
+
+	if (IsClosedLoop() == true)
+	{
+		d0 = FMath::Fmod(d0 + length, length);
+		d1 = FMath::Fmod(d1, length);
+	}
+	else
+	{
+		d0 = FMath::Max(d0, 0.0f);
+		d1 = FMath::Min(d1, length);
+		span = d1 - d0;
+	}
+
+	if (span <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	FVector up = GetUpVectorAtDistanceAlongSpline(distance, ESplineCoordinateSpace::World);
+	FVector change = GetDirectionAtDistanceAlongSpline(d1, ESplineCoordinateSpace::World) - GetDirectionAtDistanceAlongSpline(d0, ESplineCoordinateSpace::World);
+
+	change -= up * FVector::DotProduct(change, up);
+
+	return change.Size() / span;
+}
+
+/**
+* Get a value from a speed profile at a distance along the spline.
+***********************************************************************************/
+
+float UPursuitSplineComponent::GetSpeedProfileAtDistance(const TArray<float>& profile, float distance) const
+{
+	int32 numSamples = profile.Num();
+
+	if (numSamples == 0)
+	{
+		return 0.0f;
+	}
+
+	float position = distance / SpeedProfileSpacing;
+	int32 i0 = FMath::FloorToInt(position);
+	int32 i1 = i0 + 1;
+	float ratio = position - i0;
+
+	if (IsClosedLoop() == true)
+	{
+		i0 = ((i0 % numSamples) + numSamples) % numSamples;
+		i1 = (i0 + 1) % numSamples;
+	}
+	else
+	{
+		i0 = FMath::Clamp(i0, 0, numSamples - 1);
+		i1 = FMath::Clamp(i1, 0, numSamples - 1);
+	}
+
+	float v0 = profile[i0];
+	float v1 = profile[i1];
+
+	// Zero means no limit, so don't blend a limit into it.
+
+	if (v0 == 0.0f ||
+		v1 == 0.0f)
+	{
+		return (ratio < 0.5f) ? v0 : v1;
+	}
+
+	return FMath::Lerp(v0, v1, ratio);
+}
+
+/**
+* Get the expected time in seconds to drive between two distances along the spline.
+***********************************************************************************/
+
+float UPursuitSplineComponent::GetExpectedTime(float fromDistance, float toDistance, float maximumSpeed) const
+{
+	if (toDistance < fromDistance)
+	{
+		if (IsClosedLoop() == false)
+		{
+			return 0.0f;
+		}
+
+		toDistance += GetSplineLength();
+	}
+
+	float time = 0.0f;
+
+	for (float distance = fromDistance; distance < toDistance; distance += SpeedProfileSpacing)
+	{
+		float speed = GetOptimumSpeedAtDistance(FMath::Fmod(distance, GetSplineLength()));
+
+		if (speed <= 0.0f)
+		{
+			speed = maximumSpeed;
+		}
+
+		time += FMath::Min(SpeedProfileSpacing, toDistance - distance) / FMathEx::KilometersPerHourToCentimetersPerSecond(speed);
+	}
+
+	return time;
+}
+
+/**
+* Get the next route junction at or beyond a distance along the spline, or nullptr
+* if none.
+***********************************************************************************/
+
+const FRouteJunction* UPursuitSplineComponent::GetNextRouteJunction(float distance) const
+{
+	int32 numJunctions = RouteJunctions.Num();
+
+	if (numJunctions == 0)
+	{
+		return nullptr;
+	}
+
+	int32 index = Algo::LowerBoundBy(RouteJunctions, distance, [] (const FRouteJunction& junction) { return junction.Distance; });
+
+	if (index < numJunctions)
+	{
+		return &RouteJunctions[index];
+	}
+
+	return (IsClosedLoop() == true) ? &RouteJunctions[0] : nullptr;
+}
+
+/**
+* Choose a route at a junction for a difficulty level.
+*
+* The choice tables are built when the level starts, so a spline may have been
+* disabled or unloaded since, in which case we fall back to the first enabled choice,
+* staying on this spline where that's possible. Returns nullptr if no choice is
+* enabled.
+***********************************************************************************/
+
+const FRouteChoice* UPursuitSplineComponent::ChooseRoute(const FRouteJunction& junction, int32 difficultyLevel, FMathEx::FRandomFast& random) const
+{
+	int32 level = FMath::Clamp(difficultyLevel, 0, FRouteJunction::NumDifficultyLevels - 1);
+	const FRouteChoice& choice = junction.Choices[junction.ChoiceTable[level][random * FRouteJunction::ChoiceTableSize]];
+
+	if (choice.IsEnabled() == true)
+	{
+		return &choice;
+	}
+
+	for (const FRouteChoice& alternative : junction.Choices)
+	{
+		if (alternative.IsEnabled() == true)
+		{
+			return &alternative;
+		}
+	}
+
+	return nullptr;
+}
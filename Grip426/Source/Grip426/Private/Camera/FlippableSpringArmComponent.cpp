@@ -76,3 +76,71 @@ UFlippableSpringArmComponent::UFlippableSpringArmComponent()
 	CameraOffsets.Emplace(FCameraOffset(-400.0f, 400.0f, 5.0f, 5.0f, 1.0f));
 	CameraOffsets.Emplace(FCameraOffset(-200.0f, 200.0f, 5.0f, 5.0f, 0.0f));
 }
+
+/**
+* Get the camera location on an arm after collision, from an asynchronous probe
+* issued on the previous frame.
+*
+* The sweep is issued for where the arm is predicted to be next frame, given the
+* velocity of the vehicle, and the clear fraction it returns is then applied to
+* the actual arm when it's consumed, so the camera doesn't lag a frame behind the
+* collision. If the arm has barely moved since the last probe then no new one is
+* issued and the last result stands.
+***********************************************************************************/
+
+FVector UFlippableSpringArmComponent::ProbeArm(const FVector& pivot, const FVector& desired, const FVector& velocity, float deltaSeconds)
+{
+	UWorld* world = GetWorld();
+
+	if (world == nullptr)
+	{
+		return desired;
+	}
+
+	// Consume the probe issued on the last frame.
+
+	if (ProbeHandle.IsValid() == true)
+	{
+		FTraceDatum datum;
+
+		if (world->QueryTraceData(ProbeHandle, datum) == true)
+		{
+			ProbeFraction = 1.0f;
+
+			for (const FHitResult& hit : datum.OutHits)
+			{
+				if (hit.bBlockingHit == true)
+				{
+					ProbeFraction = FMath::Min(ProbeFraction, hit.Time);
+				}
+			}
+
+			ProbeHandle.Invalidate();
+		}
+		else if (world->IsTraceHandleValid(ProbeHandle, false) == false)
+		{
+			ProbeHandle.Invalidate();
+		}
+	}
+
+	// Issue the probe for the next frame.
+
+	FVector prediction = velocity * deltaSeconds;
+	FVector nextPivot = pivot + prediction;
+	FVector nextDesired = desired + prediction;
+
+	if (ProbeHandle.IsValid() == false &&
+		(ProbeIssued == false ||
+		FVector::DistSquared(nextPivot, ProbePivot) > FMath::Square(ProbeSkipDistance) ||
+		FVector::DistSquared(nextDesired, ProbeDesired) > FMath::Square(ProbeSkipDistance)))
+	{
+		FCollisionQueryParams queryParams(SCENE_QUERY_STAT(SpringArm), false, GetOwner());
+
+		ProbeHandle = world->AsyncSweepByChannel(EAsyncTraceType::Single, nextPivot, nextDesired, FQuat::Identity, ECC_Camera, FCollisionShape::MakeSphere(ProbeSize), queryParams);
+		ProbePivot = nextPivot;
+		ProbeDesired = nextDesired;
+		ProbeIssued = true;
+	}
+
+	return pivot + ((desired - pivot) * ProbeFraction);
+}
@@ -18,6 +18,7 @@
 #include "system/worldfilter.h"
 #include "vehicle/flippablevehicle.h"
 #include "gamemodes/playgamemode.h"
+#include "ai/pursuitsplinecomponent.h"
 
 /**
 * Construct a AStaticTrackCamera.
@@ -43,3 +44,144 @@ AStaticTrackCamera::AStaticTrackCamera()
 void AStaticTrackCamera::OnVehicleHit(class UPrimitiveComponent* hitComponent, class AActor* otherActor, class UPrimitiveComponent* otherComponent, int32 otherBodyIndex, bool fromSweep, const FHitResult& sweepResult)
 {
 }
+
+/**
+* Bake the visibility of the track from the camera, against the master racing
+* spline of VisibilityNavigationLayer.
+*
+* The track is sampled in buckets along the master racing spline, and in lanes
+* across its width, with a line of sight trace from the camera to the center of
+* each. Only the samples in range of the camera and within its field of view are
+* traced, the rest are left as not visible. Each bucket's lanes pack into a byte so
+* that the whole track costs a few hundred bytes per camera.
+*
+* Each navigation layer can have a different master racing spline, so the bake is
+* stored against the layer it was made for, replacing any earlier bake for it. Bake
+* once for each layer the track is raced on.
+***********************************************************************************/
+
+void AStaticTrackCamera::BakeVisibility()
+{
+	UWorld* world = GetWorld();
+	UPursuitSplineComponent* spline = APlayGameMode::DetermineMasterRacingSpline(VisibilityNavigationLayer, world, nullptr);
+
+	Modify();
+
+	BakedVisibility.RemoveAll([this] (const FTrackCameraVisibility& visibility) { return visibility.NavigationLayer == VisibilityNavigationLayer; });
+
+	VisibilityIndex = INDEX_NONE;
+
+	if (spline == nullptr ||
+		VisibilityBucketLength <= 0.0f)
+	{
+		return;
+	}
+
+	FTrackCameraVisibility& visibility = BakedVisibility[BakedVisibility.AddDefaulted()];
+
+	visibility.NavigationLayer = VisibilityNavigationLayer;
+	visibility.BucketLength = VisibilityBucketLength * 100.0f;
+	visibility.TrackWidth = VisibilityTrackWidth * 100.0f;
+
+	float length = spline->GetSplineLength();
+	int32 numBuckets = FMath::CeilToInt(length / visibility.BucketLength);
+	FVector cameraLocation = Camera->GetComponentLocation();
+	FVector cameraDirection = Camera->GetForwardVector();
+	float range = FMath::Square(VisibilityRange * 100.0f);
+	float viewAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Min((Camera->FieldOfView * 0.5f) + 10.0f, 90.0f)));
+	FCollisionQueryParams queryParams(TEXT("TrackCameraVisibility"), true, this);
+
+	visibility.Bits.SetNumZeroed(numBuckets);
+
+	for (int32 i = 0; i < numBuckets; i++)
+	{
+		float distance = FMath::Min((i + 0.5f) * visibility.BucketLength, length);
+		FVector location = spline->GetLocationAtDistanceAlongSpline(distance, ESplineCoordinateSpace::World);
+		FVector right = spline->GetRightVectorAtDistanceAlongSpline(distance, ESplineCoordinateSpace::World);
+		FVector up = spline->GetUpVectorAtDistanceAlongSpline(distance, ESplineCoordinateSpace::World);
+
+		for (int32 j = 0; j < NumVisibilityLanes; j++)
+		{
+			// Sample a meter above the center of the lane, about where a vehicle would be seen.
+
+			float lateral = ((((j + 0.5f) / NumVisibilityLanes) * 2.0f) - 1.0f) * visibility.TrackWidth;
+			FVector target = location + (right * lateral) + (up * 100.0f);
+			FVector difference = target - cameraLocation;
+
+			if (difference.SizeSquared() > range ||
+				FVector::DotProduct(difference.GetSafeNormal(), cameraDirection) < viewAngle)
+			{
+				continue;
+			}
+
+			if (world->LineTraceTestByChannel(cameraLocation, target, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false)
+			{
+				visibility.Bits[i] |= 1 << j;
+			}
+		}
+	}
+}
+
+/**
+* Select the baked visibility to use for the navigation layer of the current game.
+***********************************************************************************/
+
+void AStaticTrackCamera::SelectVisibility(const FName& navigationLayer)
+{
+	VisibilityIndex = BakedVisibility.IndexOfByPredicate([&navigationLayer] (const FTrackCameraVisibility& visibility) { return visibility.NavigationLayer == navigationLayer; });
+}
+
+/**
+* Is a location on the track potentially visible from the camera, according to the
+* baked visibility?
+*
+* If the visibility wasn't baked for the navigation layer of the current game then
+* the distances it was baked against don't apply, and every location is treated as
+* potentially visible.
+***********************************************************************************/
+
+bool AStaticTrackCamera::IsTrackVisible(float distance, float lateral) const
+{
+	if (BakedVisibility.IsValidIndex(VisibilityIndex) == false)
+	{
+		return true;
+	}
+
+	const FTrackCameraVisibility& visibility = BakedVisibility[VisibilityIndex];
+	int32 numBuckets = visibility.Bits.Num();
+
+	if (numBuckets == 0)
+	{
+		return false;
+	}
+
+	int32 bucket = FMath::FloorToInt(distance / visibility.BucketLength) % numBuckets;
+
+	if (bucket < 0)
+	{
+		bucket += numBuckets;
+	}
+
+	return (visibility.Bits[bucket] & (1 << GetVisibilityLane(visibility, lateral))) != 0;
+}
+
+/**
+* Is a location on the track visible from the camera, testing the baked visibility
+* and then confirming with a trace?
+*
+* The bake is against static geometry, so the trace is still needed to confirm that
+* nothing has moved into the way since, but it's only done for the few locations
+* that pass the bit test.
+***********************************************************************************/
+
+bool AStaticTrackCamera::CanSeeTrackLocation(const FVector& location, float distance, float lateral) const
+{
+	if (IsTrackVisible(distance, lateral) == false)
+	{
+		return false;
+	}
+
+	FCollisionQueryParams queryParams(TEXT("TrackCameraVisibility"), true, this);
+
+	return (GetWorld()->LineTraceTestByChannel(Camera->GetComponentLocation(), location, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false);
+}
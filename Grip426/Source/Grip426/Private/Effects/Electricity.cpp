@@ -26,6 +26,7 @@
 
 UMaterialInterface* UElectricalStreakComponent::StandardStreakMaterial = nullptr;
 UMaterialInterface* UElectricalStreakComponent::StandardFlareMaterial = nullptr;
+TArray<FVector> UElectricalStreakComponent::NoisePaths;
 
 /**
 * Construct an electrical streak component.
@@ -38,6 +39,114 @@ UElectricalStreakComponent::UElectricalStreakComponent()
 	PrimaryComponentTick.TickGroup = TG_DuringPhysics;
 }
 
+/**
+* Enable or disable strikes, stopping the component from ticking at all while
+* they're disabled.
+***********************************************************************************/
+
+void UElectricalStreakComponent::SetStrikesEnabled(bool enabled)
+{
+	StrikesEnabled = enabled;
+	AutoStrike = enabled;
+
+	SetComponentTickEnabled(enabled);
+}
+
+/**
+* Generate the points for a tendril between two world locations, from one of the
+* pre-generated noise paths.
+*
+* A path is selected at random, rolled at random around the line between the two
+* locations and scaled to fit it, so that no noise needs to be generated per strike.
+* The deviation is drawn once per strike so the cross-section of the path isn't
+* skewed.
+***********************************************************************************/
+
+void UElectricalStreakComponent::GenerateTendril(const FVector& start, const FVector& end, TArray<FVector>& points) const
+{
+	GenerateNoisePaths();
+
+	FVector difference = end - start;
+	float length = difference.Size();
+	int32 numPoints = FMath::Clamp(FMath::CeilToInt(length / (NumMetresPerPoint * 100.0f)) + 1, 2, FMath::Min(FMath::Max(NumPoints, 2), NumNoisePathPoints));
+
+	points.Reset(numPoints);
+
+	if (length < KINDA_SMALL_NUMBER)
+	{
+		points.Emplace(start);
+		points.Emplace(end);
+
+		return;
+	}
+
+	FVector direction = difference / length;
+	FQuat rotation = FQuat(direction, FMath::FRandRange(0.0f, PI * 2.0f)) * FRotationMatrix::MakeFromX(direction).ToQuat();
+	float deviation = length * Deviation.GetRandom();
+	FVector scale = FVector(length, deviation, deviation);
+	const FVector* path = &NoisePaths[FMath::RandHelper(NumNoisePaths) * NumNoisePathPoints];
+
+	for (int32 i = 0; i < numPoints; i++)
+	{
+		float position = ((float)i / (float)(numPoints - 1)) * (float)(NumNoisePathPoints - 1);
+		int32 index = FMath::Min(FMath::FloorToInt(position), NumNoisePathPoints - 2);
+		FVector point = FMath::Lerp(path[index], path[index + 1], position - (float)index);
+
+		points.Emplace(start + rotation.RotateVector(point * scale));
+	}
+}
+
+/**
+* Generate the noise paths shared by all of the tendrils, if they haven't been
+* already.
+*
+* Each path is generated by midpoint displacement, halving the displacement at each
+* subdivision, and is then normalized to a maximum deviation of 1.
+***********************************************************************************/
+
+void UElectricalStreakComponent::GenerateNoisePaths()
+{
+	if (NoisePaths.Num() > 0)
+	{
+		return;
+	}
+
+	NoisePaths.SetNumZeroed(NumNoisePaths * NumNoisePathPoints);
+
+	for (int32 p = 0; p < NumNoisePaths; p++)
+	{
+		FVector* path = &NoisePaths[p * NumNoisePathPoints];
+		float displacement = 0.5f;
+
+		path[NumNoisePathPoints - 1] = FVector(1.0f, 0.0f, 0.0f);
+
+		for (int32 step = NumNoisePathPoints - 1; step > 1; step >>= 1)
+		{
+			int32 half = step >> 1;
+
+			for (int32 i = half; i < NumNoisePathPoints - 1; i += step)
+			{
+				path[i] = ((path[i - half] + path[i + half]) * 0.5f) + FVector(0.0f, FMath::FRandRange(-displacement, displacement), FMath::FRandRange(-displacement, displacement));
+			}
+
+			displacement *= 0.5f;
+		}
+
+		float maxDeviation = KINDA_SMALL_NUMBER;
+
+		for (int32 i = 0; i < NumNoisePathPoints; i++)
+		{
+			maxDeviation = FMath::Max(maxDeviation, FVector2D(path[i].Y, path[i].Z).Size());
+		}
+
+		for (int32 i = 0; i < NumNoisePathPoints; i++)
+		{
+			path[i].Y /= maxDeviation;
+			path[i].Z /= maxDeviation;
+		}
+	}
+}
+
 /**
 * Construct an electrical generator.
 ***********************************************************************************/
@@ -92,20 +201,37 @@ AElectricalGenerator::AElectricalGenerator()
 	GRIP_ATTACH(EndLocationLight, StartLocation, NAME_None);
 }
 
+/**
+* Cache the streak and light components once they've all been created.
+*
+* Streaks added at runtime go into AdditionalStreaks, and are handled from there.
+***********************************************************************************/
+
+void AElectricalGenerator::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	GetComponents<UElectricalStreakComponent>(Streaks);
+	GetComponents<UPointLightComponent>(PointLights);
+}
+
 /**
 * Enable electrical strikes.
 ***********************************************************************************/
 
 void AElectricalGenerator::EnableStrikes() const
 {
-	TArray<UActorComponent*> components;
-
-	GetComponents(UElectricalStreakComponent::StaticClass(), components);
+	for (UElectricalStreakComponent* streak : Streaks)
+	{
+		streak->SetStrikesEnabled(true);
+	}
 
-	for (UActorComponent* component : components)
+	for (UElectricalStreakComponent* streak : AdditionalStreaks)
 	{
-		(Cast<UElectricalStreakComponent>(component))->StrikesEnabled = true;
-		(Cast<UElectricalStreakComponent>(component))->AutoStrike = true;
+		if (Streaks.Contains(streak) == false)
+		{
+			streak->SetStrikesEnabled(true);
+		}
 	}
 }
 
@@ -115,13 +241,16 @@ void AElectricalGenerator::EnableStrikes() const
 
 void AElectricalGenerator::DisableStrikes() const
 {
-	TArray<UActorComponent*> components;
-
-	GetComponents(UElectricalStreakComponent::StaticClass(), components);
+	for (UElectricalStreakComponent* streak : Streaks)
+	{
+		streak->SetStrikesEnabled(false);
+	}
 
-	for (UActorComponent* component : components)
+	for (UElectricalStreakComponent* streak : AdditionalStreaks)
 	{
-		(Cast<UElectricalStreakComponent>(component))->StrikesEnabled = false;
-		(Cast<UElectricalStreakComponent>(component))->AutoStrike = false;
+		if (Streaks.Contains(streak) == false)
+		{
+			streak->SetStrikesEnabled(false);
+		}
 	}
 }
@@ -15,20 +15,26 @@
 
 #include "effects/lightstreakcomponent.h"
 #include "vehicle/flippablevehicle.h"
+#include "gamemodes/basegamemode.h"
 #include "uobject/constructorhelpers.h"
 
 UMaterialInterface* ULightStreakComponent::StandardStreakMaterial = nullptr;
 UMaterialInterface* ULightStreakComponent::StandardFlareMaterial = nullptr;
+const FName ULightStreakComponent::ColourParameterName("Colour");
+const FName ULightStreakComponent::EndColourParameterName("EndColour");
+const FName ULightStreakComponent::TextureParameterName("Texture");
 
 /**
 * Construct a light streak component.
+*
+* Light streaks don't tick, they're all updated together by the light streak manager
+* in the game mode.
 ***********************************************************************************/
 
 ULightStreakComponent::ULightStreakComponent()
 {
 	bWantsInitializeComponent = true;
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.TickGroup = TG_DuringPhysics;
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 /**
@@ -55,9 +61,6 @@ UVehicleLightStreakComponent::UVehicleLightStreakComponent()
 	FlareColour = FLinearColor(1.0f, 0.195f, 0.0f, 1.0f);
 
 	SetRelativeRotation(FRotator(0.0f, 180.0f, 0.0f));
-
-	PrimaryComponentTick.bStartWithTickEnabled = false;
-	PrimaryComponentTick.SetTickFunctionEnable(false);
 }
 
 /**
@@ -66,4 +69,38 @@ UVehicleLightStreakComponent::UVehicleLightStreakComponent()
 
 void ULightStreakComponent::SetGlobalAmount(float alphaAmount, float lifeTimeAmount)
 {
+	GlobalAlphaAmount = alphaAmount;
+	GlobalLifeTimeAmount = lifeTimeAmount;
+}
+
+/**
+* Register the streak with the light streak manager.
+***********************************************************************************/
+
+void ULightStreakComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	ABaseGameMode* gameMode = ABaseGameMode::Get(this);
+
+	if (gameMode != nullptr)
+	{
+		gameMode->GetLightStreakManager().AddStreak(this);
+	}
+}
+
+/**
+* Unregister the streak from the light streak manager.
+***********************************************************************************/
+
+void ULightStreakComponent::EndPlay(const EEndPlayReason::Type endPlayReason)
+{
+	ABaseGameMode* gameMode = ABaseGameMode::Get(this);
+
+	if (gameMode != nullptr)
+	{
+		gameMode->GetLightStreakManager().RemoveStreak(this);
+	}
+
+	Super::EndPlay(endPlayReason);
 }
@@ -0,0 +1,662 @@
+/**
+*
+* Light streak manager.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Updates all of the light streaks in the game in a single pass, rather than each
+* light streak component ticking on its own. The points for every streak are kept
+* in one arena, split into fixed-size ring buffers, and the geometry for all of the
+* streaks and flares is built into a procedural mesh for each local player's view,
+* with one section for each material.
+*
+***********************************************************************************/
+
+#include "effects/lightstreakmanager.h"
+#include "effects/lightstreakcomponent.h"
+
+DEFINE_LOG_CATEGORY(GripLogLightStreaks);
+
+/**
+* Add a quad to the geometry.
+***********************************************************************************/
+
+void FLightStreakSection::AddQuad(const FVector& v0, const FVector& v1, const FVector& v2, const FVector& v3, const FLinearColor& c0, const FLinearColor& c1, float u0, float u1)
+{
+	int32 first = Vertices.Num();
+
+	Vertices.Emplace(v0);
+	Vertices.Emplace(v1);
+	Vertices.Emplace(v2);
+	Vertices.Emplace(v3);
+
+	UVs.Emplace(FVector2D(u0, 0.0f));
+	UVs.Emplace(FVector2D(u0, 1.0f));
+	UVs.Emplace(FVector2D(u1, 1.0f));
+	UVs.Emplace(FVector2D(u1, 0.0f));
+
+	Colors.Emplace(c0);
+	Colors.Emplace(c0);
+	Colors.Emplace(c1);
+	Colors.Emplace(c1);
+
+	Triangles.Emplace(first + 0);
+	Triangles.Emplace(first + 1);
+	Triangles.Emplace(first + 2);
+	Triangles.Emplace(first + 0);
+	Triangles.Emplace(first + 2);
+	Triangles.Emplace(first + 3);
+}
+
+/**
+* Register a light streak to be updated and rendered, returning false if there's no
+* room for it.
+*
+* The streak's materials are set up here from its parameters, shared with any other
+* streaks that have the same parameters so that they can be rendered together.
+***********************************************************************************/
+
+bool FLightStreakManager::AddStreak(ULightStreakComponent* component)
+{
+	if (component == nullptr ||
+		component->StreakSlot != INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Allocate the whole arena up front so that it never moves.
+
+	if (Points.Num() == 0)
+	{
+		Points.SetNum(MaxStreaks * PointsPerStreak);
+		Slots.Reserve(MaxStreaks);
+	}
+
+	int32 index = INDEX_NONE;
+
+	if (FreeSlots.Num() > 0)
+	{
+		index = FreeSlots.Pop(false);
+	}
+	else if (Slots.Num() < MaxStreaks)
+	{
+		index = Slots.AddDefaulted();
+
+		Slots[index].FirstPoint = index * PointsPerStreak;
+	}
+	else
+	{
+		NumOverflows++;
+
+		UE_LOG(GripLogLightStreaks, Warning, TEXT("Light streak manager is full with %d streaks, %s on %s won't be rendered (%d overflows)"), MaxStreaks, *component->GetName(), *GetNameSafe(component->GetOwner()), NumOverflows);
+
+		return false;
+	}
+
+	FLightStreakSlot& slot = Slots[index];
+
+	slot.Component = component;
+	slot.Head = 0;
+	slot.NumPoints = 0;
+	slot.LastLocation = component->GetComponentLocation();
+	slot.LastDirection = FVector::ZeroVector;
+	slot.Age = 0.0f;
+	slot.Alpha = 0.0f;
+	slot.Visible = false;
+
+	component->StreakSlot = index;
+
+	FLinearColor endColour = (component->StreakEndColour.R < 0.0f) ? component->StreakColour : component->StreakEndColour;
+	UMaterialInterface* streakMaterial = (component->StreakMaterial != nullptr) ? component->StreakMaterial : ULightStreakComponent::StandardStreakMaterial;
+	UMaterialInterface* flareMaterial = (component->FlareMaterial != nullptr) ? component->FlareMaterial : ULightStreakComponent::StandardFlareMaterial;
+	UMaterialInterface* centralFlareMaterial = component->CentralFlareMaterial;
+
+	if (centralFlareMaterial == nullptr &&
+		component->CentralFlareTexture != nullptr)
+	{
+		centralFlareMaterial = flareMaterial;
+	}
+
+	component->DynamicStreakMaterial = GetMaterial(streakMaterial, nullptr, component->StreakColour, endColour);
+	component->DynamicFlareMaterial = GetMaterial(flareMaterial, component->FlareTexture, component->FlareColour, component->FlareColour);
+	component->DynamicCentralFlareMaterial = GetMaterial(centralFlareMaterial, component->CentralFlareTexture, component->FlareColour, component->FlareColour);
+
+	return true;
+}
+
+/**
+* Unregister a light streak, freeing its ring buffer.
+***********************************************************************************/
+
+void FLightStreakManager::RemoveStreak(ULightStreakComponent* component)
+{
+	if (component != nullptr &&
+		Slots.IsValidIndex(component->StreakSlot) == true)
+	{
+		FLightStreakSlot& slot = Slots[component->StreakSlot];
+
+		slot.Component = nullptr;
+		slot.NumPoints = 0;
+		slot.Visible = false;
+
+		FreeSlots.Emplace(component->StreakSlot);
+
+		component->StreakSlot = INDEX_NONE;
+	}
+}
+
+/**
+* Update all of the streaks and rebuild their geometry.
+***********************************************************************************/
+
+void FLightStreakManager::Tick(UWorld* world, AActor* owner, float deltaSeconds)
+{
+	if (Slots.Num() == 0 ||
+		deltaSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	UpdateViews(world, owner);
+
+	// Update the points for all of the streaks, just the once however many views
+	// there are.
+
+	for (int32 i = 0; i < Slots.Num(); i++)
+	{
+		FLightStreakSlot& slot = Slots[i];
+
+		slot.Visible = false;
+
+		if (slot.Component.IsValid() == false)
+		{
+			// Free up slots whose components have been destroyed from under us.
+
+			if (slot.Component.IsExplicitlyNull() == false)
+			{
+				slot.Component = nullptr;
+				slot.NumPoints = 0;
+
+				FreeSlots.Emplace(i);
+			}
+
+			continue;
+		}
+
+		ULightStreakComponent* component = slot.Component.Get();
+		AActor* componentOwner = component->GetOwner();
+
+		// Streaks that aren't visible, like those on vehicles most of the time or on
+		// pooled actors, consume nothing but this check, and start afresh when they
+		// next become visible.
+
+		if (component->IsVisible() == false ||
+			component->GetGlobalAlphaAmount() <= 0.0f ||
+			(componentOwner != nullptr && componentOwner->IsHidden() == true) ||
+			(component->Streak == false && component->Flare == false))
+		{
+			slot.NumPoints = 0;
+			slot.Age = 0.0f;
+			slot.LastLocation = component->GetComponentLocation();
+
+			continue;
+		}
+
+		slot.Alpha = UpdatePoints(slot, component, deltaSeconds);
+		slot.Visible = true;
+	}
+
+	// Build the geometry for each view, facing its camera.
+
+	for (int32 v = 0; v < Views.Num(); v++)
+	{
+		FLightStreakView& view = Views[v];
+
+		for (FLightStreakSection& section : view.Sections)
+		{
+			section.Reset();
+		}
+
+		for (const FLightStreakSlot& slot : Slots)
+		{
+			if (slot.Visible == true)
+			{
+				ULightStreakComponent* component = slot.Component.Get();
+
+				if (component->Streak == true &&
+					slot.NumPoints > 1)
+				{
+					AddStreakGeometry(view, slot, component);
+				}
+
+				if (component->Flare == true &&
+					slot.Alpha > KINDA_SMALL_NUMBER)
+				{
+					AddFlareGeometry(view, component, slot.Alpha);
+				}
+			}
+		}
+
+		UProceduralMeshComponent* geometry = Geometries[v];
+
+		for (int32 i = 0; i < view.Sections.Num(); i++)
+		{
+			FLightStreakSection& section = view.Sections[i];
+
+			if (section.Vertices.Num() > 0)
+			{
+				geometry->CreateMeshSection_LinearColor(i, section.Vertices, section.Triangles, TArray<FVector>(), section.UVs, section.Colors, TArray<FProcMeshTangent>(), false);
+				geometry->SetMaterial(i, section.Material);
+			}
+			else
+			{
+				geometry->ClearMeshSection(i);
+			}
+		}
+	}
+}
+
+/**
+* Remove all of the streaks and their geometry.
+***********************************************************************************/
+
+void FLightStreakManager::Empty()
+{
+	for (FLightStreakSlot& slot : Slots)
+	{
+		if (slot.Component.IsValid() == true)
+		{
+			slot.Component->StreakSlot = INDEX_NONE;
+		}
+	}
+
+	for (UProceduralMeshComponent* geometry : Geometries)
+	{
+		if (GRIP_OBJECT_VALID(geometry) == true)
+		{
+			geometry->DestroyComponent();
+		}
+	}
+
+	if (NumOverflows > 0)
+	{
+		UE_LOG(GripLogLightStreaks, Warning, TEXT("Light streak manager overflowed its capacity of %d streaks %d times"), MaxStreaks, NumOverflows);
+	}
+
+	Points.Empty();
+	Slots.Empty();
+	FreeSlots.Empty();
+	Views.Empty();
+	Geometries.Empty();
+	Materials.Empty();
+	MaterialsByKey.Empty();
+
+	NumOverflows = 0;
+}
+
+/**
+* Match the views to the local players, each player only seeing its own view's
+* geometry.
+*
+* Camera facing geometry can only face one camera, so in split-screen there's a
+* mesh for each local player, hidden from all of the others.
+***********************************************************************************/
+
+void FLightStreakManager::UpdateViews(UWorld* world, AActor* owner)
+{
+	TArray<APlayerController*, TInlineAllocator<GRIP_MAX_LOCAL_PLAYERS>> controllers;
+
+	for (FConstPlayerControllerIterator iterator = world->GetPlayerControllerIterator(); iterator; ++iterator)
+	{
+		APlayerController* controller = iterator->Get();
+
+		if (controller != nullptr &&
+			controller->IsLocalController() == true &&
+			controller->PlayerCameraManager != nullptr)
+		{
+			controllers.Emplace(controller);
+		}
+	}
+
+	int32 numViews = FMath::Max(controllers.Num(), 1);
+
+	while (Views.Num() > numViews)
+	{
+		if (GRIP_OBJECT_VALID(Geometries.Last()) == true)
+		{
+			Geometries.Last()->DestroyComponent();
+		}
+
+		Views.Pop();
+		Geometries.Pop();
+	}
+
+	while (Views.Num() < numViews)
+	{
+		UProceduralMeshComponent* geometry = NewObject<UProceduralMeshComponent>(owner);
+
+		geometry->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		geometry->CastShadow = false;
+		geometry->RegisterComponent();
+
+		Views.AddDefaulted();
+		Geometries.Emplace(geometry);
+	}
+
+	for (int32 i = 0; i < Views.Num(); i++)
+	{
+		FLightStreakView& view = Views[i];
+		APlayerController* controller = (controllers.IsValidIndex(i) == true) ? controllers[i] : nullptr;
+
+		view.Controller = controller;
+		view.CameraLocation = (controller != nullptr) ? controller->PlayerCameraManager->GetCameraLocation() : FVector::ZeroVector;
+
+		if (controller != nullptr &&
+			controllers.Num() > 1)
+		{
+			for (int32 j = 0; j < Geometries.Num(); j++)
+			{
+				if (j == i)
+				{
+					controller->HiddenPrimitiveComponents.Remove(Geometries[j]);
+				}
+				else
+				{
+					controller->HiddenPrimitiveComponents.AddUnique(Geometries[j]);
+				}
+			}
+		}
+	}
+}
+
+/**
+* Update the points for a streak, returning its current alpha.
+*
+* The newest point always tracks the component, and it's left behind as a fixed
+* point once it's far enough from the last fixed point or the streak has turned
+* enough since then.
+***********************************************************************************/
+
+float FLightStreakManager::UpdatePoints(FLightStreakSlot& slot, ULightStreakComponent* component, float deltaSeconds)
+{
+	float lifeTime = FMath::Max(component->LifeTime * component->GetGlobalLifeTimeAmount(), KINDA_SMALL_NUMBER);
+	FVector location = component->GetComponentLocation();
+	FVector movement = location - slot.LastLocation;
+	float speed = movement.Size() / deltaSeconds;
+
+	slot.Age += deltaSeconds;
+	slot.LastLocation = location;
+
+	// Age the points and drop those that have expired from the tail.
+
+	for (int32 i = 0; i < slot.NumPoints; i++)
+	{
+		GetPoint(slot, i).Age += deltaSeconds;
+	}
+
+	while (slot.NumPoints > 0 &&
+		GetPoint(slot, slot.NumPoints - 1).Age > lifeTime)
+	{
+		slot.NumPoints--;
+	}
+
+	// Determine the alpha for the streak right now.
+
+	float alpha = component->Alpha * component->GetGlobalAlphaAmount();
+
+	if (component->MaxSpeed > component->MinSpeed)
+	{
+		alpha *= FMath::Clamp((speed - component->MinSpeed) / (component->MaxSpeed - component->MinSpeed), 0.0f, 1.0f);
+	}
+
+	if (component->FadeInTime > 0.0f)
+	{
+		alpha *= FMath::Min(slot.Age / component->FadeInTime, 1.0f);
+	}
+
+	if (component->FadeStreakOnVelocityDeviation == true &&
+		speed > KINDA_SMALL_NUMBER)
+	{
+		// Streaks point backwards from their parent, so compare against the reverse of
+		// the direction of travel.
+
+		float dotProduct = FVector::DotProduct(component->GetForwardVector(), movement.GetSafeNormal() * -1.0f);
+		float amount = component->FadeStreakOnVelocityDeviationAmount;
+
+		alpha *= (amount < 1.0f) ? FMath::Clamp((dotProduct - amount) / (1.0f - amount), 0.0f, 1.0f) : 1.0f;
+	}
+
+	if (component->Streak == false ||
+		component->ManualConstruction == true)
+	{
+		return alpha;
+	}
+
+	// Add new points as necessary.
+
+	bool addPoint = (slot.NumPoints < 2);
+
+	if (addPoint == false)
+	{
+		FVector difference = location - GetPoint(slot, 1).Location;
+		float distance = difference.Size();
+
+		if (component->MaxDistance <= 0.0f ||
+			distance > component->MaxDistance)
+		{
+			addPoint = true;
+		}
+		else if (distance > component->MinDistance)
+		{
+			FVector direction = difference / distance;
+
+			addPoint = (FMathEx::DotProductToDegrees(FVector::DotProduct(direction, slot.LastDirection)) > component->MaxAngle);
+		}
+
+		if (addPoint == true &&
+			distance > KINDA_SMALL_NUMBER)
+		{
+			slot.LastDirection = difference / distance;
+		}
+	}
+
+	if (addPoint == true)
+	{
+		if (slot.NumPoints > 0 &&
+			component->StreakNoise > 0.0f)
+		{
+			GetPoint(slot, 0).Location += FMath::VRand() * component->StreakNoise * component->Width * 0.5f;
+		}
+
+		slot.Head = (slot.Head + 1) % PointsPerStreak;
+		slot.NumPoints = FMath::Min(slot.NumPoints + 1, PointsPerStreak);
+	}
+
+	FLightStreakPoint& head = GetPoint(slot, 0);
+
+	head.Location = location;
+	head.Up = component->GetUpVector();
+	head.Age = 0.0f;
+	head.Alpha = alpha;
+
+	return alpha;
+}
+
+/**
+* Add the geometry for a streak to the section for its material.
+*
+* The color and alpha along the streak go into the vertex colors, the material
+* having the streak's color parameters too for those that prefer them.
+***********************************************************************************/
+
+void FLightStreakManager::AddStreakGeometry(FLightStreakView& view, const FLightStreakSlot& slot, ULightStreakComponent* component)
+{
+	if (component->DynamicStreakMaterial == nullptr)
+	{
+		return;
+	}
+
+	FLightStreakSection& section = GetSection(view, component->DynamicStreakMaterial);
+	float lifeTime = FMath::Max(component->LifeTime * component->GetGlobalLifeTimeAmount(), KINDA_SMALL_NUMBER);
+	FLinearColor endColour = (component->StreakEndColour.R < 0.0f) ? component->StreakColour : component->StreakEndColour;
+	int32 first = section.Vertices.Num();
+	int32 numPoints = slot.NumPoints;
+
+	for (int32 i = 0; i < numPoints; i++)
+	{
+		const FLightStreakPoint& point = GetPoint(slot, i);
+		const FVector& next = GetPoint(slot, FMath::Max(i - 1, 0)).Location;
+		const FVector& previous = GetPoint(slot, FMath::Min(i + 1, numPoints - 1)).Location;
+		float ratio = FMath::Min(point.Age / lifeTime, 1.0f);
+		float width = component->Width * 0.5f * FMath::Lerp(1.0f, component->TailShrinkScale, ratio);
+		FVector side = point.Up;
+
+		if (component->CameraFacing == true)
+		{
+			side = FVector::CrossProduct(next - previous, view.CameraLocation - point.Location).GetSafeNormal();
+		}
+
+		FLinearColor colour = FMath::Lerp(component->StreakColour, endColour, ratio);
+
+		colour.A = point.Alpha * FMath::Pow(1.0f - ratio, component->AlphaFadePower);
+
+		float u = (float)i / (float)(numPoints - 1);
+
+		section.Vertices.Emplace(point.Location + (side * width));
+		section.Vertices.Emplace(point.Location - (side * width));
+		section.UVs.Emplace(FVector2D(u, 0.0f));
+		section.UVs.Emplace(FVector2D(u, 1.0f));
+		section.Colors.Emplace(colour);
+		section.Colors.Emplace(colour);
+
+		if (i > 0)
+		{
+			int32 v = first + (i * 2);
+
+			section.Triangles.Emplace(v - 2);
+			section.Triangles.Emplace(v - 1);
+			section.Triangles.Emplace(v + 1);
+			section.Triangles.Emplace(v - 2);
+			section.Triangles.Emplace(v + 1);
+			section.Triangles.Emplace(v);
+		}
+	}
+}
+
+/**
+* Add the geometry for the flares of a streak to the sections for their materials.
+***********************************************************************************/
+
+void FLightStreakManager::AddFlareGeometry(FLightStreakView& view, ULightStreakComponent* component, float alpha)
+{
+	FVector location = component->GetComponentLocation();
+	FVector toCamera = (view.CameraLocation - location).GetSafeNormal();
+
+	if (component->FadeFlareOnAngleDeviation == true)
+	{
+		float amount = component->FadeFlareOnAngleDeviationAmount;
+		float dotProduct = FVector::DotProduct(component->GetForwardVector(), toCamera);
+
+		alpha *= (amount < 1.0f) ? FMath::Clamp((dotProduct - amount) / (1.0f - amount), 0.0f, 1.0f) : 1.0f;
+
+		if (alpha <= KINDA_SMALL_NUMBER)
+		{
+			return;
+		}
+	}
+
+	// Build a basis facing the camera, optionally rolled with the component.
+
+	FVector up = (component->AutoRotateFlare == false && component->UseFlareRotation == true) ? component->GetUpVector() : FVector::UpVector;
+	FVector right = FVector::CrossProduct(up, toCamera).GetSafeNormal();
+
+	up = FVector::CrossProduct(toCamera, right);
+
+	FLinearColor colour = component->FlareColour;
+
+	colour.A = alpha;
+
+	if (component->DynamicFlareMaterial != nullptr)
+	{
+		FVector x = right * component->Size * 0.5f * component->AspectRatio;
+		FVector y = up * component->Size * 0.5f;
+
+		GetSection(view, component->DynamicFlareMaterial).AddQuad(location - x + y, location - x - y, location + x - y, location + x + y, colour, colour);
+	}
+
+	if (component->DynamicCentralFlareMaterial != nullptr)
+	{
+		FVector x = right * component->CentralSize * 0.5f * component->CentralAspectRatio;
+		FVector y = up * component->CentralSize * 0.5f;
+
+		GetSection(view, component->DynamicCentralFlareMaterial).AddQuad(location - x + y, location - x - y, location + x - y, location + x + y, colour, colour);
+	}
+}
+
+/**
+* Get the section for a material within a view, adding one if necessary.
+***********************************************************************************/
+
+FLightStreakSection& FLightStreakManager::GetSection(FLightStreakView& view, UMaterialInterface* material)
+{
+	for (FLightStreakSection& section : view.Sections)
+	{
+		if (section.Material == material)
+		{
+			return section;
+		}
+	}
+
+	FLightStreakSection& section = view.Sections[view.Sections.AddDefaulted()];
+
+	section.Material = material;
+
+	return section;
+}
+
+/**
+* Get a shared dynamic material with the given parameters, creating it if necessary.
+*
+* Streaks with the same material, texture and colors share the same dynamic material
+* so that their geometry can still be batched into the same mesh section.
+***********************************************************************************/
+
+UMaterialInstanceDynamic* FLightStreakManager::GetMaterial(UMaterialInterface* parent, UTexture* texture, const FLinearColor& colour, const FLinearColor& endColour)
+{
+	if (parent == nullptr)
+	{
+		return nullptr;
+	}
+
+	FLightStreakMaterialKey key;
+
+	key.Parent = parent;
+	key.Texture = texture;
+	key.Colour = colour;
+	key.EndColour = endColour;
+
+	UMaterialInstanceDynamic** found = MaterialsByKey.Find(key);
+
+	if (found != nullptr)
+	{
+		return *found;
+	}
+
+	UMaterialInstanceDynamic* material = UMaterialInstanceDynamic::Create(parent, GetTransientPackage());
+
+	material->SetVectorParameterValue(ULightStreakComponent::ColourParameterName, colour);
+	material->SetVectorParameterValue(ULightStreakComponent::EndColourParameterName, endColour);
+
+	if (texture != nullptr)
+	{
+		material->SetTextureParameterValue(ULightStreakComponent::TextureParameterName, texture);
+	}
+
+	Materials.Emplace(material);
+	MaterialsByKey.Emplace(key, material);
+
+	return material;
+}
@@ -150,6 +150,108 @@ void FPlayerRaceState::Tick(float deltaSeconds, APlayGameMode* gameMode, UGlobal
 
 void FPlayerRaceState::UpdateCheckpoints(bool ignoreCheckpointSize)
 {
+	APlayGameMode* gameMode = APlayGameMode::Get(PlayerVehicle);
+	const TArray<ATrackCheckpoint*>& checkpoints = gameMode->Checkpoints;
+	int32 numCheckpoints = checkpoints.Num();
+
+	if (numCheckpoints == 0)
+	{
+		return;
+	}
+
+	if (NextCheckpoint < 0)
+	{
+		NextCheckpoint = 0;
+		LastCheckpoint = numCheckpoints - 1;
+	}
+
+	// Sweep the vehicle's movement over the whole of the last frame, across however
+	// many physics sub-steps it took, against the next checkpoint and, in case that was
+	// somehow missed, the one after it. We never need to test any others as the
+	// checkpoints have to be passed in order.
+
+	FVector to = PlayerVehicle->GetPhysics().PhysicsTransform.GetLocation();
+	FVector from = (CheckpointSweepValid == true) ? CheckpointSweepLocation : to;
+
+	CheckpointSweepLocation = to;
+	CheckpointSweepValid = true;
+
+	for (int32 i = 0; i < 2 && i < numCheckpoints; i++)
+	{
+		int32 index = (NextCheckpoint + i) % numCheckpoints;
+		ATrackCheckpoint* checkpoint = checkpoints[index];
+		const FTransform& transform = checkpoint->PassingVolume->GetComponentTransform();
+		FVector normal = transform.GetUnitAxis(EAxis::X);
+		float d0 = FVector::DotProduct(from - transform.GetLocation(), normal);
+		float d1 = FVector::DotProduct(to - transform.GetLocation(), normal);
+
+		// Only crossings in the forward direction of the checkpoint count.
+
+		if (d0 < 0.0f &&
+			d1 >= 0.0f)
+		{
+			if (checkpoint->UseCheckpointSize == true &&
+				ignoreCheckpointSize == false)
+			{
+				// Transform the crossing point into the local space of the passing volume
+				// and check that it lies within the extents of its plane.
+
+				FVector crossing = transform.InverseTransformPosition(FMath::Lerp(from, to, d0 / (d0 - d1)));
+				FVector extent = checkpoint->PassingVolume->GetUnscaledBoxExtent();
+
+				if (FMath::Abs(crossing.Y) > extent.Y ||
+					FMath::Abs(crossing.Z) > extent.Z)
+				{
+					continue;
+				}
+			}
+
+			// If we skipped a checkpoint to get here then the start line may have been the
+			// one skipped, and that lap still counts.
+
+			bool passedStart = false;
+
+			for (int32 j = 0; j <= i; j++)
+			{
+				passedStart |= ((NextCheckpoint + j) % numCheckpoints == 0);
+			}
+
+			CheckpointsReached += i + 1;
+			LastCheckpoint = index;
+			NextCheckpoint = (index + 1) % numCheckpoints;
+
+			if (passedStart == true)
+			{
+				// The first checkpoint is the start line, so we've completed a lap.
+
+				LapNumber++;
+				EternalLapNumber++;
+
+				if (LapNumber > 0)
+				{
+					LastLapTime = LapTime;
+					BestLapTime = (BestLapTime == 0.0f) ? LapTime : FMath::Min(BestLapTime, LapTime);
+					LapCompleted = true;
+
+					gameMode->PublishRaceEvent(FRaceEvent(ERaceEventType::LapCompleted, PlayerVehicle->VehicleIndex, LapNumber));
+				}
+
+				LapTime = 0.0f;
+				MaxLapNumber = FMath::Max(MaxLapNumber, LapNumber);
+
+				UGlobalGameState* gameState = UGlobalGameState::GetGlobalGameState(PlayerVehicle);
+
+				if (gameState->IsGameModeLapBased() == true &&
+					LapNumber >= gameState->GeneralOptions.NumberOfLaps &&
+					IsAccountingClosed() == false)
+				{
+					PlayerComplete(true, false, false);
+				}
+			}
+
+			break;
+		}
+	}
 }
 
 /**
@@ -175,6 +277,8 @@ void FPlayerRaceState::PlayerComplete(bool setCompletionStatus, bool gameComplet
 			disqualified == false)
 		{
 			PlayerCompletionState = completionState;
+
+			gameMode->PublishRaceEvent(FRaceEvent(ERaceEventType::Finished, PlayerVehicle->VehicleIndex, (int32)completionState));
 		}
 
 		if (gameState->GamePlaySetup.DrivingMode != EDrivingMode::Elimination)
@@ -218,6 +218,17 @@ void ABaseGameMode::BeginPlay()
 	physicsSettings->MaxSubsteps = FMath::CeilToInt((1.0f / physicsSettings->MaxSubstepDeltaTime) / 20.0f);
 }
 
+/**
+* Do some shutdown when the actor is being destroyed.
+***********************************************************************************/
+
+void ABaseGameMode::EndPlay(const EEndPlayReason::Type endPlayReason)
+{
+	LightStreakManager.Empty();
+
+	Super::EndPlay(endPlayReason);
+}
+
 /**
 * Do the regular update tick.
 ***********************************************************************************/
@@ -252,6 +263,11 @@ void ABaseGameMode::Tick(float deltaSeconds)
 		RealTimeGameClockStart += RealTimeClock - RealTimeGameClockPausedTime;
 		RealTimeGameClockPausedTime = 0.0;
 	}
+
+	// Update all of the light streaks now that everything they're attached to has
+	// moved for the frame.
+
+	LightStreakManager.Tick(GetWorld(), this, deltaSeconds);
 }
 
 /**
@@ -25,7 +25,16 @@
 #include "components/canvaspanelslot.h"
 #include "components/image.h"
 #include "camera/statictrackcamera.h"
+#include "pickups/homingmissile.h"
+#include "pickups/gatlinggun.h"
+#include "pickups/shield.h"
+#include "pickups/turbo.h"
+#include "effects/electricalbomb.h"
 #include "ui/hudwidget.h"
+#include "sceneview.h"
+#include "algo/binarysearch.h"
+#include "algo/sort.h"
+#include "async/parallelfor.h"
 
 /**
 * APlayGameMode statics.
@@ -34,6 +43,21 @@
 // The type of widget to use for the single screen UI.
 TSubclassOf<USingleHUDWidget> APlayGameMode::SingleScreenWidgetClass = nullptr;
 
+// The distance from the nearest human player beyond which AI bots decide at a reduced rate, in centimeters.
+const float APlayGameMode::AIReducedRateDistance = 200.0f * 100.0f;
+
+// The lateral grip assumed when baking the speed profiles of the pursuit splines, in G.
+const float APlayGameMode::SpeedProfileLateralGrip = 2.0f;
+
+// The acceleration assumed when baking the speed profiles of the pursuit splines, in G.
+const float APlayGameMode::SpeedProfileAcceleration = 0.5f;
+
+// The braking assumed when baking the speed profiles of the pursuit splines, in G.
+const float APlayGameMode::SpeedProfileBraking = 1.0f;
+
+// The top speed assumed when baking the speed profiles of the pursuit splines, in KPH.
+const float APlayGameMode::SpeedProfileMaximumSpeed = 500.0f;
+
 /**
 * Construct a play game mode.
 ***********************************************************************************/
@@ -273,6 +297,51 @@ void APlayGameMode::BeginPlay()
 	BuildPursuitSplines(false, FName(*GlobalGameState->TransientGameState.NavigationLayer), world, GlobalGameState, MasterRacingSpline.Get());
 	EstablishPursuitSplineLinks(false, FName(*GlobalGameState->TransientGameState.NavigationLayer), world, GlobalGameState, MasterRacingSpline.Get());
 
+	// Record all of the checkpoints in traversal order, along with where they sit on the
+	// master racing spline.
+
+	Checkpoints.Empty();
+
+	for (TActorIterator<ATrackCheckpoint> actorItr(world); actorItr; ++actorItr)
+	{
+		if (FWorldFilter::IsValid(*actorItr, GlobalGameState) == true)
+		{
+			ATrackCheckpoint* checkpoint = *actorItr;
+
+			if (MasterRacingSpline.IsValid() == true)
+			{
+				checkpoint->DistanceAlongMasterRacingSpline = MasterRacingSpline->GetNearestDistance(checkpoint->GetActorLocation());
+			}
+
+			Checkpoints.Emplace(checkpoint);
+		}
+	}
+
+	Checkpoints.Sort([] (const ATrackCheckpoint& object1, const ATrackCheckpoint& object2)
+		{
+			return object1.Order < object2.Order;
+		});
+
+	BuildTrackCameraIndex();
+
+	// Register the missile assistance splines so that missiles can use their baked
+	// ground offsets for following the terrain.
+
+	for (TActorIterator<APursuitSplineActor> actorItr(GetWorld()); actorItr; ++actorItr)
+	{
+		if (FWorldFilter::IsValid(*actorItr, GlobalGameState) == true)
+		{
+			TArray<UActorComponent*> splines;
+
+			(*actorItr)->GetComponents(UPursuitSplineComponent::StaticClass(), splines);
+
+			for (UActorComponent* component : splines)
+			{
+				MissileManager.AddAssistanceSpline(Cast<UPursuitSplineComponent>(component));
+			}
+		}
+	}
+
 	int32 index = 0;
 
 	Vehicles.Empty();
@@ -318,6 +387,12 @@ void APlayGameMode::BeginPlay()
 	}
 
 	LastOptionsResetTime = GetClock();
+
+	PrewarmActorPools();
+
+#if GRIP_LOG_EVICTED_GAME_EVENTS
+	GameEventLog = IFileManager::Get().CreateFileWriter(*FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Logs"), TEXT("GameEvents.bin")));
+#endif // GRIP_LOG_EVICTED_GAME_EVENTS
 }
 
 /**
@@ -338,9 +413,151 @@ void APlayGameMode::EndPlay(const EEndPlayReason::Type endPlayReason)
 
 	ChangeTimeDilation(1.0f, 0.0f);
 
+	for (auto& pool : ActorPools)
+	{
+		pool.Value.LogStatistics();
+		pool.Value.Empty();
+	}
+
+	ActorPools.Empty();
+
+	VehicleAudioManager.Empty();
+	MissileManager.Empty();
+	GunRoundManager.Empty();
+
+#if GRIP_LOG_EVICTED_GAME_EVENTS
+	if (GameEventLog != nullptr)
+	{
+		// Flush out the events still held in the ring.
+
+		for (int32 i = 0; i < GetNumGameEvents(); i++)
+		{
+			GameEventLog->Serialize(const_cast<FGameEvent*>(GetGameEvent(i)), sizeof(FGameEvent));
+		}
+
+		GameEventLog->Close();
+
+		delete GameEventLog;
+
+		GameEventLog = nullptr;
+	}
+#endif // GRIP_LOG_EVICTED_GAME_EVENTS
+
 	Super::EndPlay(endPlayReason);
 }
 
+/**
+* Create and prewarm the actor pools for the pickups.
+*
+* The capacities are the most of each that we'd expect to be alive at once across
+* all of the vehicles, missiles being fired in pairs at level 2. Pools are allowed
+* to overflow, but they'll warn when they do so that the capacities can be tuned.
+***********************************************************************************/
+
+void APlayGameMode::PrewarmActorPools()
+{
+	int32 numPlayers = CalculateMaxPlayers();
+
+	struct FPoolSetup
+	{
+		UClass* ActorClass;
+		int32 PerPlayer;
+	};
+
+	FPoolSetup pools[] =
+	{
+		{ ABaseVehicle::Level1MissileBlueprint.Get(), 1 },
+		{ ABaseVehicle::Level2MissileBlueprint.Get(), 2 },
+		{ ABaseVehicle::Level1GatlingGunBlueprint.Get(), 1 },
+		{ ABaseVehicle::Level2GatlingGunBlueprint.Get(), 1 },
+		{ ABaseVehicle::Level1ShieldBlueprint.Get(), 1 },
+		{ ABaseVehicle::Level2ShieldBlueprint.Get(), 1 },
+		{ ABaseVehicle::Level1TurboBlueprint.Get(), 1 },
+		{ ABaseVehicle::Level2TurboBlueprint.Get(), 1 },
+		{ ABaseVehicle::DestroyedElectricalBomb.Get(), 1 }
+	};
+
+	UWorld* world = GetWorld();
+
+	for (const FPoolSetup& setup : pools)
+	{
+		if (setup.ActorClass != nullptr &&
+			ActorPools.Contains(setup.ActorClass) == false)
+		{
+			FActorPool& pool = ActorPools.Emplace(setup.ActorClass, FActorPool(setup.ActorClass, numPlayers * setup.PerPlayer));
+
+			pool.Prewarm(world);
+		}
+	}
+}
+
+/**
+* Acquire an actor of a class from its pool, spawning one if there isn't a pool for
+* the class.
+***********************************************************************************/
+
+AActor* APlayGameMode::AcquirePooledActor(UClass* actorClass, const FTransform& transform, AActor* owner, APawn* instigator)
+{
+	FActorPool* pool = ActorPools.Find(actorClass);
+
+	if (pool != nullptr)
+	{
+		return pool->Acquire(GetWorld(), transform, owner, instigator);
+	}
+
+	FActorSpawnParameters spawnParams;
+
+	spawnParams.Owner = owner;
+	spawnParams.Instigator = instigator;
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	return GetWorld()->SpawnActor<AActor>(actorClass, transform, spawnParams);
+}
+
+/**
+* Return an actor to its pool, destroying it if it doesn't have one.
+***********************************************************************************/
+
+void APlayGameMode::ReleasePooledActor(AActor* actor)
+{
+	if (actor != nullptr)
+	{
+		FActorPool* pool = ActorPools.Find(actor->GetClass());
+
+		if (pool != nullptr)
+		{
+			pool->Release(actor);
+		}
+		else
+		{
+			actor->Destroy();
+		}
+	}
+}
+
+/**
+* Add a homing missile to the game, to be simulated by the missile manager.
+***********************************************************************************/
+
+void APlayGameMode::AddMissile(AHomingMissile* missile, const FVector& velocity)
+{
+	if (missile != nullptr)
+	{
+		Missiles.AddUnique(missile);
+		MissileManager.AddMissile(missile, velocity);
+	}
+}
+
+/**
+* Remove a homing missile from the game.
+***********************************************************************************/
+
+void APlayGameMode::RemoveMissile(AHomingMissile* missile)
+{
+	Missiles.Remove(missile);
+	MissileManager.RemoveMissile(missile);
+}
+
 /**
 * Determine the vehicles that are currently present in the level.
 ***********************************************************************************/
@@ -424,6 +641,34 @@ UPursuitSplineComponent* APlayGameMode::DetermineMasterRacingSpline(const FName&
 
 void APlayGameMode::BuildPursuitSplines(bool check, const FName& navigationLayer, UWorld* world, UGlobalGameState* gameState, UPursuitSplineComponent* masterRacingSpline)
 {
+	if (check == true)
+	{
+		return;
+	}
+
+	for (TActorIterator<APursuitSplineActor> actorItr0(world); actorItr0; ++actorItr0)
+	{
+		if ((gameState != nullptr && FWorldFilter::IsValid(*actorItr0, gameState) == true) ||
+			(gameState == nullptr && FWorldFilter::IsValid(*actorItr0, navigationLayer) == true))
+		{
+			TArray<UActorComponent*> splines;
+
+			(*actorItr0)->GetComponents(UPursuitSplineComponent::StaticClass(), splines);
+
+			for (UActorComponent* component : splines)
+			{
+				UPursuitSplineComponent* spline = Cast<UPursuitSplineComponent>(component);
+
+				if (spline->GetNumberOfSplinePoints() > 1)
+				{
+					// Bake the speed profile so that bots can look up their target speeds by
+					// distance rather than looking ahead for corners every frame.
+
+					spline->BuildSpeedProfile(SpeedProfileLateralGrip, SpeedProfileAcceleration, SpeedProfileBraking, SpeedProfileMaximumSpeed);
+				}
+			}
+		}
+	}
 }
 
 /**
@@ -432,6 +677,233 @@ void APlayGameMode::BuildPursuitSplines(bool check, const FName& navigationLayer
 
 void APlayGameMode::EstablishPursuitSplineLinks(bool check, const FName& navigationLayer, UWorld* world, UGlobalGameState* gameState, UPursuitSplineComponent* masterRacingSpline)
 {
+	if (check == true)
+	{
+		return;
+	}
+
+	TArray<UPursuitSplineComponent*> pursuitSplines;
+
+	for (TActorIterator<APursuitSplineActor> actorItr0(world); actorItr0; ++actorItr0)
+	{
+		if ((gameState != nullptr && FWorldFilter::IsValid(*actorItr0, gameState) == true) ||
+			(gameState == nullptr && FWorldFilter::IsValid(*actorItr0, navigationLayer) == true))
+		{
+			TArray<UActorComponent*> splines;
+
+			(*actorItr0)->GetComponents(UPursuitSplineComponent::StaticClass(), splines);
+
+			for (UActorComponent* component : splines)
+			{
+				UPursuitSplineComponent* spline = Cast<UPursuitSplineComponent>(component);
+
+				if (spline->GetNumberOfSplinePoints() > 1 &&
+					spline->Type != EPursuitSplineType::MissileAssistance)
+				{
+					spline->RouteJunctions.Empty();
+
+					pursuitSplines.Emplace(spline);
+				}
+			}
+		}
+	}
+
+	// The distance in cm between the end of one spline and another for them to be linked.
+	const float linkDistance = 10.0f * 100.0f;
+
+	// The speed in KPH we consider splines with no optimum speed to be driven at.
+	const float maximumSpeed = 500.0f;
+
+	int32 numLinks = 0;
+
+	for (UPursuitSplineComponent* spline : pursuitSplines)
+	{
+		float length = spline->GetSplineLength();
+
+		for (UPursuitSplineComponent* branch : pursuitSplines)
+		{
+			if (branch == spline)
+			{
+				continue;
+			}
+
+			// A branch leaves this spline if its start point lies on it.
+
+			FVector branchStart = branch->GetLocationAtSplinePoint(0, ESplineCoordinateSpace::World);
+			float junctionDistance = spline->GetNearestDistance(branchStart);
+
+			if ((spline->GetLocationAtDistanceAlongSpline(junctionDistance, ESplineCoordinateSpace::World) - branchStart).Size() > linkDistance)
+			{
+				continue;
+			}
+
+			// See if, and where, the branch rejoins this spline.
+
+			FVector branchEnd = branch->GetLocationAtSplinePoint(branch->GetNumberOfSplinePoints() - 1, ESplineCoordinateSpace::World);
+			float rejoinDistance = spline->GetNearestDistance(branchEnd);
+			bool rejoins = (branch->IsClosedLoop() == false && (spline->GetLocationAtDistanceAlongSpline(rejoinDistance, ESplineCoordinateSpace::World) - branchEnd).Size() <= linkDistance);
+
+			if (rejoins == false)
+			{
+				rejoinDistance = length;
+			}
+
+			FRouteJunction* junction = spline->RouteJunctions.FindByPredicate([junctionDistance, linkDistance] (const FRouteJunction& existing) { return FMath::Abs(existing.Distance - junctionDistance) <= linkDistance; });
+
+			if (junction == nullptr)
+			{
+				junction = &spline->RouteJunctions[spline->RouteJunctions.AddDefaulted()];
+				junction->Distance = junctionDistance;
+
+				// Staying on this spline is always the first choice, where possible. Its
+				// length and time are measured once all of the branches are known.
+
+				if (spline->IsClosedLoop() == true ||
+					junctionDistance < length - linkDistance)
+				{
+					FRouteChoice stay;
+
+					stay.Spline = spline;
+					stay.Distance = junctionDistance;
+					stay.RejoinDistance = junctionDistance;
+					stay.PickupValue = (spline->ContainsPickups == true) ? 1.0f : 0.0f;
+
+					junction->Choices.Emplace(stay);
+				}
+			}
+
+			FRouteChoice choice;
+
+			choice.Spline = branch;
+			choice.Distance = 0.0f;
+			choice.Length = branch->GetSplineLength();
+			choice.ExpectedTime = branch->GetExpectedTime(0.0f, choice.Length, maximumSpeed);
+			choice.RejoinDistance = rejoinDistance;
+			choice.PickupValue = (branch->ContainsPickups == true) ? 1.0f : 0.0f;
+			choice.MinimumDifficultyLevel = (branch->IsShortcut == true) ? 1 : 0;
+
+			junction->Choices.Emplace(choice);
+
+			numLinks++;
+		}
+
+		spline->RouteJunctions.Sort([] (const FRouteJunction& a, const FRouteJunction& b) { return a.Distance < b.Distance; });
+
+		// Now build the weighted choice tables for each junction, so that bots can
+		// select a route with a single table lookup.
+
+		auto getSpan = [length] (float fromDistance, float toDistance) { return (toDistance >= fromDistance) ? toDistance - fromDistance : length - fromDistance + toDistance; };
+
+		for (FRouteJunction& junction : spline->RouteJunctions)
+		{
+			// Branches rejoin this spline at different points, so bring all of the choices
+			// to the furthest of those points before comparing their times. Otherwise a
+			// branch that rejoins early is compared against staying over a different span.
+
+			float commonSpan = 0.0f;
+
+			for (const FRouteChoice& choice : junction.Choices)
+			{
+				if (choice.Spline.Get() != spline)
+				{
+					commonSpan = FMath::Max(commonSpan, getSpan(junction.Distance, choice.RejoinDistance));
+				}
+			}
+
+			float commonDistance = junction.Distance + commonSpan;
+
+			if (commonDistance > length)
+			{
+				commonDistance -= length;
+			}
+
+			float fastestTime = BIG_NUMBER;
+			bool alwaysSelect = false;
+			TArray<float> times;
+
+			for (FRouteChoice& choice : junction.Choices)
+			{
+				float time = 0.0f;
+
+				if (choice.Spline.Get() == spline)
+				{
+					choice.RejoinDistance = commonDistance;
+					choice.Length = commonSpan;
+					choice.ExpectedTime = time = spline->GetExpectedTime(junction.Distance, commonDistance, maximumSpeed);
+				}
+				else if (choice.ExpectedTime > 0.0f)
+				{
+					time = choice.ExpectedTime + spline->GetExpectedTime(choice.RejoinDistance, commonDistance, maximumSpeed);
+				}
+
+				if (time > 0.0f)
+				{
+					fastestTime = FMath::Min(fastestTime, time);
+				}
+
+				times.Emplace(time);
+
+				alwaysSelect |= (choice.IsEnabled() == true && choice.Spline->AlwaysSelect == true);
+			}
+
+			for (int32 level = 0; level < FRouteJunction::NumDifficultyLevels; level++)
+			{
+				float totalWeight = 0.0f;
+				TArray<float> weights;
+
+				for (int32 c = 0; c < junction.Choices.Num(); c++)
+				{
+					const FRouteChoice& choice = junction.Choices[c];
+					float weight = 0.0f;
+
+					if (choice.IsEnabled() == true &&
+						choice.MinimumDifficultyLevel <= level &&
+						(alwaysSelect == false || choice.Spline->AlwaysSelect == true))
+					{
+						// Higher difficulty bots favor the faster routes more strongly.
+
+						weight = FMath::Max(choice.Spline->BranchProbability, 0.0f) * (1.0f + choice.PickupValue);
+
+						if (times[c] > 0.0f &&
+							fastestTime < BIG_NUMBER)
+						{
+							weight *= FMath::Pow(fastestTime / times[c], (float)level);
+						}
+					}
+
+					totalWeight += weight;
+					weights.Emplace(weight);
+				}
+
+				// Each table entry covers an equal slice of the total weight.
+
+				for (int32 i = 0; i < FRouteJunction::ChoiceTableSize; i++)
+				{
+					int32 c = 0;
+
+					if (totalWeight > 0.0f)
+					{
+						float target = ((i + 0.5f) / FRouteJunction::ChoiceTableSize) * totalWeight;
+						float sum = 0.0f;
+
+						for (c = 0; c < weights.Num() - 1; c++)
+						{
+							sum += weights[c];
+
+							if (sum > target)
+							{
+								break;
+							}
+						}
+					}
+
+					junction.ChoiceTable[level][i] = (uint8)c;
+				}
+			}
+		}
+	}
+
+	UE_LOG(GripLogPursuitSplines, Log, TEXT("Established %d links between %d pursuit splines"), numLinks, pursuitSplines.Num());
 }
 
 /**
@@ -452,6 +924,11 @@ void APlayGameMode::Tick(float deltaSeconds)
 		LastOptionsResetTime = clock;
 	}
 
+	// Calculate the track-space positions of everything that moves up front, so that
+	// all of the systems that need them can share the results.
+
+	UpdateTrackFrames();
+
 	// Handle the update of each game sequence by calling the appropriate function.
 
 	switch (GameSequence)
@@ -464,49 +941,781 @@ void APlayGameMode::Tick(float deltaSeconds)
 	case EGameSequence::Start:
 		UpdateRaceStartLine();
 		UpdateRacePositions(deltaSeconds);
+		UpdatePackStatistics();
+		UpdateHUDRaceSnapshot();
 		break;
 
 	case EGameSequence::Play:
 		UpdateRacePositions(deltaSeconds);
+		UpdatePackStatistics();
+		UpdateHUDRaceSnapshot();
 		UpdateUILoading();
 		break;
 
 	case EGameSequence::End:
 		UpdateRacePositions(deltaSeconds);
+		UpdatePackStatistics();
+		UpdateHUDRaceSnapshot();
 		UpdateUILoading();
 		break;
 	}
-}
 
-/**
-* Upload the loading of the main UI.
-***********************************************************************************/
+	UpdateAIDrivers();
 
-void APlayGameMode::UpdateUILoading()
-{
-	if (GameSequence == EGameSequence::End)
-	{
-		QuitGame();
-	}
-}
+	// Rank the vehicles by how well they can be heard to budget the audio voices.
 
-/**
-* Restart the game.
+	VehicleAudioManager.Tick(GetWorld(), GetVehicles());
+
+	// Advance all of the homing missiles together, and warn the vehicles they're
+	// heading for.
+
+	MissileManager.Tick(GetWorld(), deltaSeconds);
+
+	Missiles.RemoveAll([] (AHomingMissile* missile)
+		{
+			return GRIP_OBJECT_VALID(missile) == false;
+		});
+
+	for (ABaseVehicle* vehicle : Vehicles)
+	{
+		vehicle->HUD.MissileWarningAmount = MissileManager.GetThreat(vehicle->VehicleIndex).WarningAmount;
+	}
+
+	// Resolve the gun rounds fired last frame and submit those fired since, all
+	// together in one batch.
+
+	GunRoundManager.Tick(GetWorld(), this);
+
+	// Dispatch the race events in one batch at this fixed point in the frame, so that
+	// subscribers always see them in the order that they were published.
+
+	DispatchRaceEvents();
+}
+
+/**
+* Dispatch all of the race events published since the last dispatch.
+*
+* Changes in race position are detected here rather than being published, as the
+* positions are all calculated together once per frame.
+***********************************************************************************/
+
+void APlayGameMode::DispatchRaceEvents()
+{
+	int32 numVehicles = Vehicles.Num();
+
+	if (DispatchedRacePositions.Num() != numVehicles)
+	{
+		DispatchedRacePositions.Init(-1, numVehicles);
+	}
+
+	for (int32 i = 0; i < numVehicles; i++)
+	{
+		int32 position = Vehicles[i]->GetRaceState().RacePosition;
+
+		if (DispatchedRacePositions[i] != position)
+		{
+			if (DispatchedRacePositions[i] >= 0)
+			{
+				PublishRaceEvent(FRaceEvent(ERaceEventType::PositionChanged, Vehicles[i]->VehicleIndex, position, DispatchedRacePositions[i]));
+			}
+
+			DispatchedRacePositions[i] = position;
+		}
+	}
+
+	if (PendingRaceEvents.Num() > 0)
+	{
+		Swap(PendingRaceEvents, DispatchingRaceEvents);
+
+		for (const FRaceEvent& raceEvent : DispatchingRaceEvents)
+		{
+			RaceEventDelegates[(int32)raceEvent.Type].Broadcast(raceEvent);
+		}
+
+		DispatchingRaceEvents.Reset();
+	}
+}
+
+/**
+* Record the destruction of a player for this game.
+***********************************************************************************/
+
+void APlayGameMode::DestroyPlayer(ABaseVehicle* vehicle)
+{
+	NumPlayersDestroyed++;
+
+	PublishRaceEvent(FRaceEvent(ERaceEventType::Eliminated, vehicle->VehicleIndex, NumPlayersDestroyed));
+}
+
+/**
+* Upload the loading of the main UI.
+***********************************************************************************/
+
+void APlayGameMode::UpdateUILoading()
+{
+	if (GameSequence == EGameSequence::End)
+	{
+		QuitGame();
+	}
+}
+
+/**
+* Restart the game.
+***********************************************************************************/
+
+void APlayGameMode::RestartGame()
+{
+	UE_LOG(GripLog, Log, TEXT("APlayGameMode::RestartGame"));
+
+	Super::RestartGame();
+}
+
+/**
+* Quit the game.
+***********************************************************************************/
+
+void APlayGameMode::QuitGame(bool force)
+{
+}
+
+/**
+* Update the track frames for all of the vehicles, missiles and avoidables.
+*
+* As we're ticking post update work, these reflect the final positions for the
+* frame, which other actors then see on the next frame.
+***********************************************************************************/
+
+void APlayGameMode::UpdateTrackFrames()
+{
+	Swap(TrackFrames, LastTrackFrames);
+
+	TrackFrames.Reset(Vehicles.Num() + Missiles.Num() + Avoidables.Num());
+
+	UPursuitSplineComponent* spline = MasterRacingSpline.Get();
+
+	if (spline == nullptr)
+	{
+		return;
+	}
+
+	// The range either side of the last distance to search for the new distance, in cm.
+	// An actor that has moved further than this since the last frame has been teleported
+	// or reset, and the search isn't limited to around its last distance.
+	const float searchRange = 50.0f * 100.0f;
+
+	// The offset from the spline beyond which a limited search is assumed to have found
+	// the wrong part of it, in cm.
+	const float maximumOffset = 25.0f * 100.0f;
+
+	auto addFrame = [this, spline, searchRange, maximumOffset] (AActor* actor)
+	{
+		int32 index = TrackFrames.AddDefaulted();
+		FTrackFrame& frame = TrackFrames[index];
+		FVector location = actor->GetActorLocation();
+		float lastDistance = -1.0f;
+
+		if (LastTrackFrames.IsValidIndex(index) == true &&
+			LastTrackFrames[index].Actor == actor &&
+			(LastTrackFrames[index].Location - location).SizeSquared() < FMath::Square(searchRange))
+		{
+			lastDistance = LastTrackFrames[index].Distance;
+		}
+
+		frame.Actor = actor;
+		frame.Location = location;
+		frame.Distance = spline->GetNearestDistance(location, lastDistance, searchRange);
+
+		FTransform transform = spline->GetTransformAtDistanceAlongSpline(frame.Distance, ESplineCoordinateSpace::World);
+		FVector offset = location - transform.GetLocation();
+
+		// The limited search can lock onto a local minimum where the spline doubles back
+		// near itself, so search the whole spline if we've ended up far away from it.
+
+		if (lastDistance >= 0.0f &&
+			offset.SizeSquared() > FMath::Square(maximumOffset))
+		{
+			frame.Distance = spline->GetNearestDistance(location);
+			transform = spline->GetTransformAtDistanceAlongSpline(frame.Distance, ESplineCoordinateSpace::World);
+			offset = location - transform.GetLocation();
+		}
+
+		frame.Forward = transform.GetUnitAxis(EAxis::X);
+		frame.Right = transform.GetUnitAxis(EAxis::Y);
+		frame.Up = transform.GetUnitAxis(EAxis::Z);
+		frame.Lateral = FVector::DotProduct(offset, frame.Right);
+		frame.Vertical = FVector::DotProduct(offset, frame.Up);
+	};
+
+	// Vehicles must come first and all be present to keep GetVehicleTrackFrame valid.
+
+	for (ABaseVehicle* vehicle : Vehicles)
+	{
+		addFrame(vehicle);
+	}
+
+	for (AHomingMissile* missile : Missiles)
+	{
+		if (missile != nullptr)
+		{
+			addFrame(missile);
+		}
+	}
+
+	for (auto& avoidable : Avoidables)
+	{
+		if (avoidable.Key != nullptr)
+		{
+			addFrame(avoidable.Key);
+		}
+	}
+}
+
+/**
+* Take the snapshot of the race for the HUD.
+*
+* All of the HUD bindings for all of the local players then read from this rather
+* than each walking the vehicle list for themselves.
+***********************************************************************************/
+
+void APlayGameMode::UpdateHUDRaceSnapshot()
+{
+	FHUDRaceSnapshot& snapshot = HUDRaceSnapshot;
+
+	snapshot.FrameNumber = FrameNumber;
+
+	for (int32 i = 0; i < GRIP_MAX_PLAYERS; i++)
+	{
+		snapshot.Present[i] = false;
+		snapshot.Destroyed[i] = true;
+		snapshot.PackScales[i] = 0;
+	}
+
+	for (ABaseVehicle* vehicle : Vehicles)
+	{
+		int32 index = vehicle->VehicleIndex;
+
+		if (index >= 0 &&
+			index < GRIP_MAX_PLAYERS)
+		{
+			snapshot.Present[index] = true;
+			snapshot.Destroyed[index] = vehicle->IsVehicleDestroyed();
+			snapshot.RaceDistances[index] = vehicle->GetRaceState().RaceDistance;
+			snapshot.Colours[index] = GetTeamColour(-1);
+		}
+	}
+
+	// The pack scale for each viewer is the distance to the furthest vehicle from it,
+	// clamped to a sensible range.
+
+	for (int32 i = 0; i < GRIP_MAX_PLAYERS; i++)
+	{
+		if (snapshot.Present[i] == true)
+		{
+			float maxDistance = 0.0f;
+
+			for (int32 j = 0; j < GRIP_MAX_PLAYERS; j++)
+			{
+				if (j != i &&
+					snapshot.Present[j] == true &&
+					snapshot.Destroyed[j] == false)
+				{
+					maxDistance = FMath::Max(maxDistance, FMath::Abs(snapshot.RaceDistances[j] - snapshot.RaceDistances[i]));
+				}
+			}
+
+			snapshot.PackScales[i] = (int32)(FMath::Clamp(maxDistance, 500.0f * 100.0f, 2000.0f * 100.0f) / 100.0f);
+		}
+	}
+}
+
+/**
+* Get the track frame for an actor, or nullptr if it doesn't have one.
+***********************************************************************************/
+
+const FTrackFrame* APlayGameMode::FindTrackFrame(const AActor* actor) const
+{
+	for (const FTrackFrame& frame : TrackFrames)
+	{
+		if (frame.Actor == actor)
+		{
+			return &frame;
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+* Compute the statistics on the pack of vehicles and the catch-up scalars for this
+* frame.
+*
+* The pack is described by its extents and centres, and each vehicle by how far it
+* leads or trails the distance the catch-up aims to congregate it around. For human
+* players that's the center of the human players, and for AI bots it's that center
+* offset by CentreOffset, if there are any humans. The catch-up scalars are then
+* evaluated for all of the vehicles together, four at a time, so that each vehicle
+* only has to read its values from the tables.
+***********************************************************************************/
+
+void APlayGameMode::UpdatePackStatistics()
+{
+	FPackStatistics& pack = PackStatistics;
+	FDifficultyCharacteristics& difficulty = GetDifficultyCharacteristics();
+	const FVehicleCatchupCharacteristics& catchup = difficulty.VehicleCatchupCharacteristics;
+	const FWeaponCatchupCharacteristics& weapons = difficulty.WeaponCatchupCharacteristics;
+	bool humanAssist = GlobalGameState->GetCatchupAssist();
+
+	pack.FrameNumber = FrameNumber;
+	pack.NumVehicles = 0;
+	pack.NumHumans = 0;
+
+	for (int32 i = 0; i < GRIP_MAX_PLAYERS; i++)
+	{
+		pack.Present[i] = false;
+		pack.Human[i] = false;
+	}
+
+	for (int32 i = 0; i < FPackStatistics::NumPadded; i++)
+	{
+		pack.RaceDistances[i] = 0.0f;
+	}
+
+	float centre = 0.0f;
+	float humanCentre = 0.0f;
+
+	for (ABaseVehicle* vehicle : Vehicles)
+	{
+		int32 index = vehicle->VehicleIndex;
+
+		if (index >= 0 &&
+			index < GRIP_MAX_PLAYERS &&
+			vehicle->IsVehicleDestroyed() == false)
+		{
+			float distance = vehicle->GetRaceState().RaceDistance;
+
+			pack.Present[index] = true;
+			pack.Human[index] = (vehicle->HasAIDriver() == false);
+			pack.RaceDistances[index] = distance;
+			pack.Order[pack.NumVehicles++] = index;
+
+			centre += distance;
+
+			if (pack.Human[index] == true)
+			{
+				humanCentre += distance;
+				pack.NumHumans++;
+			}
+		}
+	}
+
+	if (pack.NumVehicles == 0)
+	{
+		return;
+	}
+
+	Algo::Sort(MakeArrayView(pack.Order, pack.NumVehicles), [&pack] (int32 index1, int32 index2)
+		{
+			return pack.RaceDistances[index1] > pack.RaceDistances[index2];
+		});
+
+	pack.Front = pack.RaceDistances[pack.Order[0]];
+	pack.Rear = pack.RaceDistances[pack.Order[pack.NumVehicles - 1]];
+	pack.Centre = centre / pack.NumVehicles;
+	pack.BotCentre = (pack.NumVehicles > pack.NumHumans) ? (centre - humanCentre) / (pack.NumVehicles - pack.NumHumans) : pack.Centre;
+
+	if (pack.NumHumans > 0)
+	{
+		pack.HumanCentre = humanCentre / pack.NumHumans;
+		pack.HumanFront = -BIG_NUMBER;
+		pack.HumanRear = BIG_NUMBER;
+
+		for (int32 i = 0; i < pack.NumVehicles; i++)
+		{
+			int32 index = pack.Order[i];
+
+			if (pack.Human[index] == true)
+			{
+				pack.HumanFront = FMath::Max(pack.HumanFront, pack.RaceDistances[index]);
+				pack.HumanRear = FMath::Min(pack.HumanRear, pack.RaceDistances[index]);
+			}
+		}
+
+		pack.TargetCentre = pack.HumanCentre + (catchup.CentreOffset * 100.0f);
+	}
+	else
+	{
+		pack.HumanCentre = pack.HumanFront = pack.HumanRear = pack.Centre;
+		pack.TargetCentre = pack.Centre;
+	}
+
+	// Gather the coefficients for each vehicle, which differ between humans and bots,
+	// so that the evaluation itself is branch-free. Humans are measured against the
+	// bots, so that a lone human still leads or trails the pack, while bots are measured
+	// against the centre they're meant to congregate around.
+
+	alignas(16) float dragFront[FPackStatistics::NumPadded];
+	alignas(16) float dragRear[FPackStatistics::NumPadded];
+	alignas(16) float gripFront[FPackStatistics::NumPadded];
+	alignas(16) float gripRear[FPackStatistics::NumPadded];
+	alignas(16) float accelerationRear[FPackStatistics::NumPadded];
+	alignas(16) float centres[FPackStatistics::NumPadded];
+
+	for (int32 i = 0; i < FPackStatistics::NumPadded; i++)
+	{
+		bool present = (i < GRIP_MAX_PLAYERS && pack.Present[i] == true);
+		bool human = (present == true && pack.Human[i] == true);
+		bool assist = (present == true && (human == false || humanAssist == true));
+
+		centres[i] = (human == true) ? pack.BotCentre : pack.TargetCentre;
+
+		dragFront[i] = (assist == false) ? 0.0f : (human == true) ? catchup.DragScaleAtFrontHumans : catchup.DragScaleAtFrontNonHumans;
+		dragRear[i] = (assist == false) ? 0.0f : (human == true) ? catchup.DragScaleAtRearHumans : catchup.DragScaleAtRearNonHumans;
+		gripFront[i] = (assist == false || human == true) ? 0.0f : catchup.GripScaleAtFrontNonHumans;
+		gripRear[i] = (assist == false) ? 0.0f : (human == true) ? catchup.GripScaleAtRearHumans : catchup.GripScaleAtRearNonHumans;
+		accelerationRear[i] = (assist == false) ? 0.0f : catchup.LowSpeedAccelerationScaleAtRear;
+	}
+
+	float halfSpread = FMath::Max(catchup.DistanceSpread * 100.0f * 0.5f, 1.0f);
+	float aggressionRange = FMath::Max((weapons.TrailingDistance + weapons.LeadingDistance) * 100.0f, 1.0f);
+	VectorRegister inverseHalfSpread = VectorSetFloat1(1.0f / halfSpread);
+	VectorRegister trailingDistance = VectorSetFloat1(weapons.TrailingDistance * 100.0f);
+	VectorRegister inverseAggressionRange = VectorSetFloat1(1.0f / aggressionRange);
+	VectorRegister zero = VectorZero();
+	VectorRegister one = VectorOne();
+	VectorRegister minusOne = VectorNegate(one);
+
+	for (int32 i = 0; i < FPackStatistics::NumPadded; i += 4)
+	{
+		VectorRegister lead = VectorSubtract(VectorLoadAligned(pack.RaceDistances + i), VectorLoadAligned(centres + i));
+		VectorRegister ratio = VectorMin(VectorMax(VectorMultiply(lead, inverseHalfSpread), minusOne), one);
+		VectorRegister front = VectorMax(ratio, zero);
+		VectorRegister rear = VectorMax(VectorNegate(ratio), zero);
+
+		// Drag rises at the front and falls at the rear, grip falls at the front and
+		// rises at the rear, and low-speed acceleration rises at the rear.
+
+		VectorRegister drag = VectorSubtract(VectorMultiplyAdd(front, VectorLoadAligned(dragFront + i), one), VectorMultiply(rear, VectorLoadAligned(dragRear + i)));
+		VectorRegister grip = VectorSubtract(VectorMultiplyAdd(rear, VectorLoadAligned(gripRear + i), one), VectorMultiply(front, VectorLoadAligned(gripFront + i)));
+		VectorRegister acceleration = VectorMultiplyAdd(rear, VectorLoadAligned(accelerationRear + i), one);
+		VectorRegister aggression = VectorMin(VectorMax(VectorMultiply(VectorAdd(lead, trailingDistance), inverseAggressionRange), zero), one);
+
+		VectorStoreAligned(lead, pack.LeadDistances + i);
+		VectorStoreAligned(ratio, pack.CatchupRatios + i);
+		VectorStoreAligned(drag, pack.DragScales + i);
+		VectorStoreAligned(grip, pack.GripScales + i);
+		VectorStoreAligned(acceleration, pack.AccelerationScales + i);
+		VectorStoreAligned(aggression, pack.WeaponAggression + i);
+	}
+
+	for (ABaseVehicle* vehicle : Vehicles)
+	{
+		int32 index = vehicle->VehicleIndex;
+
+		if (index >= 0 &&
+			index < GRIP_MAX_PLAYERS &&
+			pack.Present[index] == true)
+		{
+			FPlayerRaceState& raceState = vehicle->GetRaceState();
+
+			raceState.RaceCatchupRatio = pack.CatchupRatios[index];
+			raceState.DragScale = pack.DragScales[index];
+		}
+	}
+}
+
+/**
+* Get the aggression for one vehicle to use offensive weapons against another, from
+* 0 timid to 1 aggressive.
+*
+* Targets trailing the attacker are attacked timidly and those leading it are
+* attacked aggressively, with separate bands for human and bot targets.
+***********************************************************************************/
+
+float APlayGameMode::GetWeaponAggression(int32 attackerIndex, int32 targetIndex) const
+{
+	const FPackStatistics& pack = PackStatistics;
+
+	if (attackerIndex < 0 ||
+		attackerIndex >= GRIP_MAX_PLAYERS ||
+		targetIndex < 0 ||
+		targetIndex >= GRIP_MAX_PLAYERS ||
+		pack.Present[attackerIndex] == false ||
+		pack.Present[targetIndex] == false)
+	{
+		return 0.0f;
+	}
+
+	const FWeaponCatchupCharacteristics& weapons = GetDifficultyCharacteristics().WeaponCatchupCharacteristics;
+	float trailing = ((pack.Human[targetIndex] == true) ? weapons.TrailingDistanceHumans : weapons.TrailingDistanceNonHumans) * 100.0f;
+	float leading = ((pack.Human[targetIndex] == true) ? weapons.LeadingDistanceHumans : weapons.LeadingDistanceNonHumans) * 100.0f;
+	float lead = pack.RaceDistances[targetIndex] - pack.RaceDistances[attackerIndex];
+
+	return FMath::Clamp((lead + trailing) / FMath::Max(trailing + leading, 1.0f), 0.0f, 1.0f);
+}
+
+/**
+* Build the index of the track camera detection intervals along the master racing
+* spline.
+*
+* Each camera is assigned the distance along the master racing spline nearest to
+* it, and its detection interval is laid around that. Finding the cameras to use is
+* then a lookup of the vehicle distances in the sorted intervals rather than scans
+* and overlap events against every camera.
+***********************************************************************************/
+
+void APlayGameMode::BuildTrackCameraIndex()
+{
+	UWorld* world = GetWorld();
+
+	TrackCameras.Empty();
+	TrackCameraIntervals.Empty();
+	MaxTrackCameraInterval = 0.0f;
+
+	for (TActorIterator<AStaticTrackCamera> actorItr(world); actorItr; ++actorItr)
+	{
+		if (FWorldFilter::IsValid(*actorItr, GlobalGameState) == true)
+		{
+			TrackCameras.Emplace(*actorItr);
+		}
+	}
+
+	if (MasterRacingSpline.IsValid() == false ||
+		MasterRacingSplineLength <= 0.0f)
+	{
+		return;
+	}
+
+	bool closedLoop = MasterRacingSpline->IsClosedLoop();
+
+	for (int32 i = 0; i < TrackCameras.Num(); i++)
+	{
+		AStaticTrackCamera* camera = TrackCameras[i];
+		float distance = MasterRacingSpline->GetNearestDistance(camera->GetActorLocation());
+		float start = distance - (camera->DetectionDistanceBefore * 100.0f);
+		float end = distance + (camera->DetectionDistanceAfter * 100.0f);
+
+		camera->DistanceAlongMasterRacingSpline = distance;
+		camera->SelectVisibility(FName(*GlobalGameState->TransientGameState.NavigationLayer));
+
+		if (closedLoop == true &&
+			start < 0.0f)
+		{
+			TrackCameraIntervals.Emplace(FTrackCameraInterval{ start + MasterRacingSplineLength, MasterRacingSplineLength, i });
+
+			start = 0.0f;
+		}
+
+		if (closedLoop == true &&
+			end > MasterRacingSplineLength)
+		{
+			TrackCameraIntervals.Emplace(FTrackCameraInterval{ 0.0f, end - MasterRacingSplineLength, i });
+
+			end = MasterRacingSplineLength;
+		}
+
+		TrackCameraIntervals.Emplace(FTrackCameraInterval{ start, end, i });
+	}
+
+	for (const FTrackCameraInterval& interval : TrackCameraIntervals)
+	{
+		MaxTrackCameraInterval = FMath::Max(MaxTrackCameraInterval, interval.EndDistance - interval.StartDistance);
+	}
+
+	TrackCameraIntervals.Sort([] (const FTrackCameraInterval& object1, const FTrackCameraInterval& object2)
+		{
+			return object1.StartDistance < object2.StartDistance;
+		});
+}
+
+/**
+* Get the track cameras that currently have enough vehicles in their detection
+* intervals to be used.
+***********************************************************************************/
+
+void APlayGameMode::GetTrackCameraCandidates(TArray<AStaticTrackCamera*>& candidates) const
+{
+	candidates.Reset();
+
+	if (TrackCameraIntervals.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<64>> numVehicles;
+
+	numVehicles.SetNumZeroed(TrackCameras.Num());
+
+	// Any interval containing a distance must start no earlier than the longest
+	// interval before it, so only that slice of the index needs to be checked.
+
+	for (int32 i = 0; i < Vehicles.Num(); i++)
+	{
+		const FTrackFrame* frame = GetVehicleTrackFrame(i);
+
+		if (frame == nullptr)
+		{
+			continue;
+		}
+
+		float distance = frame->Distance;
+		int32 first = Algo::LowerBoundBy(TrackCameraIntervals, distance - MaxTrackCameraInterval, [] (const FTrackCameraInterval& interval) { return interval.StartDistance; });
+
+		for (int32 j = first; j < TrackCameraIntervals.Num() && TrackCameraIntervals[j].StartDistance <= distance; j++)
+		{
+			if (TrackCameraIntervals[j].EndDistance >= distance)
+			{
+				numVehicles[TrackCameraIntervals[j].CameraIndex]++;
+			}
+		}
+	}
+
+	for (int32 i = 0; i < TrackCameras.Num(); i++)
+	{
+		if (numVehicles[i] > 0 &&
+			numVehicles[i] >= FMath::Min(TrackCameras[i]->NumberOfVehicles, Vehicles.Num()))
+		{
+			candidates.Emplace(TrackCameras[i]);
+		}
+	}
+}
+
+/**
+* Update the AI bot drivers, deciding in parallel from a snapshot of the world and
+* then applying serially.
+*
+* The read phase runs a task per bot, each only reading the snapshot and its own
+* vehicle, and the write phase then applies the decisions on the game thread. Bots
+* far from every human player decide at a reduced rate, staggered by vehicle index
+* so that they don't all land on the same frame.
 ***********************************************************************************/
 
-void APlayGameMode::RestartGame()
+void APlayGameMode::UpdateAIDrivers()
 {
-	UE_LOG(GripLog, Log, TEXT("APlayGameMode::RestartGame"));
+	AIDeciders.Reset();
 
-	Super::RestartGame();
+	for (ABaseVehicle* vehicle : Vehicles)
+	{
+		if (vehicle->HasAIDriver() == true)
+		{
+			AIDeciders.Emplace(vehicle);
+		}
+	}
+
+	if (AIDeciders.Num() == 0)
+	{
+		return;
+	}
+
+	BuildAISnapshot();
+
+	float reducedRateDistance = FMath::Square(AIReducedRateDistance);
+
+	AIDeciders.RemoveAll([this, reducedRateDistance] (ABaseVehicle* vehicle)
+		{
+			if (AISnapshot.Vehicles.IsValidIndex(vehicle->VehicleIndex) == false)
+			{
+				return true;
+			}
+
+			if (((FrameNumber + vehicle->VehicleIndex) % AIReducedRateFrames) == 0)
+			{
+				return false;
+			}
+
+			const FVector& location = AISnapshot.Vehicles[vehicle->VehicleIndex].Location;
+
+			for (const FVehicleAISnapshot& other : AISnapshot.Vehicles)
+			{
+				if (other.Human == true &&
+					FVector::DistSquared(other.Location, location) < reducedRateDistance)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		});
+
+	AIDecisions.SetNum(AIDeciders.Num());
+
+	ParallelFor(AIDeciders.Num(), [this] (int32 index)
+		{
+			AIDeciders[index]->DecideAI(AISnapshot, AIDecisions[index]);
+		});
+
+	for (int32 i = 0; i < AIDeciders.Num(); i++)
+	{
+		AIDeciders[i]->ApplyAIDecision(AIDecisions[i]);
+	}
 }
 
 /**
-* Quit the game.
+* Take the snapshot of the world for the AI bot drivers to decide from.
 ***********************************************************************************/
 
-void APlayGameMode::QuitGame(bool force)
+void APlayGameMode::BuildAISnapshot()
 {
+	AISnapshot.FrameNumber = FrameNumber;
+	AISnapshot.Avoidables.Reset();
+
+	// The vehicles in the snapshot are keyed by vehicle index rather than by their
+	// position in the Vehicles array, as that's how they're looked up.
+
+	int32 numVehicles = 0;
+
+	for (ABaseVehicle* vehicle : Vehicles)
+	{
+		numVehicles = FMath::Max(numVehicles, vehicle->VehicleIndex + 1);
+	}
+
+	AISnapshot.Vehicles.Reset();
+	AISnapshot.Vehicles.SetNum(numVehicles);
+
+	for (int32 i = 0; i < Vehicles.Num(); i++)
+	{
+		ABaseVehicle* vehicle = Vehicles[i];
+
+		if (vehicle->VehicleIndex < 0)
+		{
+			continue;
+		}
+
+		FVehicleAISnapshot& snapshot = AISnapshot.Vehicles[vehicle->VehicleIndex];
+		const FTrackFrame* frame = GetVehicleTrackFrame(i);
+
+		snapshot.Location = vehicle->GetActorLocation();
+		snapshot.Velocity = vehicle->GetVelocity();
+		snapshot.Direction = vehicle->GetVelocityOrFacingDirection();
+		snapshot.TrackDistance = (frame != nullptr) ? frame->Distance : 0.0f;
+		snapshot.RacePosition = vehicle->GetRaceState().RacePosition;
+		snapshot.Human = (vehicle->HasAIDriver() == false);
+		snapshot.Destroyed = vehicle->IsVehicleDestroyed();
+		snapshot.Valid = true;
+		snapshot.SteeringInput = vehicle->Control.SteeringInputAnalog;
+		snapshot.ThrottleInput = vehicle->Control.ThrottleInput;
+		snapshot.BrakeInput = vehicle->Control.BrakeInput;
+		snapshot.DrivingMode = vehicle->AI.DrivingMode;
+		snapshot.HeadingTo = vehicle->AI.HeadingTo;
+	}
+
+	// Vehicles register themselves as avoidables too, but they're already in the
+	// snapshot as vehicles so skip them here.
+
+	for (auto& avoidable : Avoidables)
+	{
+		if (GRIP_OBJECT_VALID(avoidable.Key) == true &&
+			Cast<ABaseVehicle>(avoidable.Key) == nullptr &&
+			avoidable.Value->IsAvoidanceActive() == true)
+		{
+			FAvoidableAISnapshot snapshot;
+
+			snapshot.Location = avoidable.Value->GetAvoidanceLocation();
+			snapshot.Velocity = avoidable.Value->GetAvoidanceVelocity();
+			snapshot.Radius = avoidable.Value->GetAvoidanceRadius();
+
+			AISnapshot.Avoidables.Emplace(snapshot);
+		}
+	}
 }
 
 /**
@@ -683,9 +1892,161 @@ void APlayGameMode::AddGameEvent(FGameEvent& gameEvent)
 
 	gameEvent.Time = GetRealTimeClock();
 
-	// Record the event.
+	gameEvent.OfInterest = (gameEvent.EventType == EGameEventType::Blocked ||
+		gameEvent.EventType == EGameEventType::Destroyed ||
+		gameEvent.EventType == EGameEventType::ChatMessage ||
+		(gameEvent.EventType == EGameEventType::Impacted && gameEvent.PickupUsed == EPickupType::HomingMissile));
+
+	if (gameEvent.EventType == EGameEventType::Impacted &&
+		gameEvent.TargetVehicleIndex >= 0)
+	{
+		PublishRaceEvent(FRaceEvent(ERaceEventType::WeaponHit, gameEvent.TargetVehicleIndex, (int32)gameEvent.PickupUsed, gameEvent.LaunchVehicleIndex));
+	}
+
+	// Record the event, overwriting the oldest one once the ring is full.
+
+	uint32 sequence = NumGameEventsAdded++;
+	FGameEvent& slot = GameEvents[sequence % MaxGameEvents];
+
+#if GRIP_LOG_EVICTED_GAME_EVENTS
+	if (GameEventLog != nullptr &&
+		sequence >= MaxGameEvents)
+	{
+		GameEventLog->Serialize(&slot, sizeof(FGameEvent));
+	}
+#endif // GRIP_LOG_EVICTED_GAME_EVENTS
+
+	if (sequence >= MaxGameEvents)
+	{
+		ReleaseGameEventString(slot.ExtraInformation);
+	}
+
+	slot = gameEvent;
+
+	if (GameEventStrings.IsValidIndex(slot.ExtraInformation) == true)
+	{
+		GameEventStringReferences[slot.ExtraInformation]++;
+	}
+
+	// Index the event against the vehicles involved if it's of interest, so the HUD
+	// can find each player's recent events directly.
+
+	if (gameEvent.OfInterest == true)
+	{
+		int32 vehicleIndices[] = { gameEvent.LaunchVehicleIndex, gameEvent.TargetVehicleIndex };
+
+		for (int32 i = 0; i < 2; i++)
+		{
+			int32 vehicleIndex = vehicleIndices[i];
+
+			if (vehicleIndex >= 0 &&
+				vehicleIndex < GRIP_MAX_PLAYERS &&
+				(i == 0 || vehicleIndex != vehicleIndices[0]))
+			{
+				PlayerEventsOfInterest[vehicleIndex][NumPlayerEventsOfInterest[vehicleIndex]++ % MaxPlayerEventsOfInterest] = sequence;
+			}
+		}
+	}
+}
+
+/**
+* Get the number of events of interest retained for a vehicle.
+***********************************************************************************/
+
+int32 APlayGameMode::GetNumPlayerEventsOfInterest(int32 vehicleIndex) const
+{
+	if (vehicleIndex < 0 ||
+		vehicleIndex >= GRIP_MAX_PLAYERS)
+	{
+		return 0;
+	}
+
+	// Events may have left the main ring before the player's ring, so only count
+	// those that are still retained.
+
+	uint32 oldest = NumGameEventsAdded - GetNumGameEvents();
+	uint32 numEvents = NumPlayerEventsOfInterest[vehicleIndex];
+	int32 count = 0;
+
+	while (count < MaxPlayerEventsOfInterest &&
+		(uint32)count < numEvents &&
+		PlayerEventsOfInterest[vehicleIndex][(numEvents - 1 - count) % MaxPlayerEventsOfInterest] >= oldest)
+	{
+		count++;
+	}
+
+	return count;
+}
+
+/**
+* Get an event of interest for a vehicle, 0 being the most recent, or nullptr if
+* none.
+***********************************************************************************/
+
+const FGameEvent* APlayGameMode::GetPlayerEventOfInterest(int32 vehicleIndex, int32 index) const
+{
+	if (index < 0 ||
+		index >= GetNumPlayerEventsOfInterest(vehicleIndex))
+	{
+		return nullptr;
+	}
+
+	uint32 sequence = PlayerEventsOfInterest[vehicleIndex][(NumPlayerEventsOfInterest[vehicleIndex] - 1 - index) % MaxPlayerEventsOfInterest];
+
+	return &GameEvents[sequence % MaxGameEvents];
+}
+
+/**
+* Intern a string for use in game events, returning its ID.
+*
+* Strings are reference-counted by the events in the ring that use them, so they're
+* freed as those events are overwritten rather than accumulating for the whole game.
+***********************************************************************************/
+
+int32 APlayGameMode::InternGameEventString(const FString& text)
+{
+	int32* id = GameEventStringIDs.Find(text);
+
+	if (id != nullptr)
+	{
+		return *id;
+	}
+
+	int32 newID = INDEX_NONE;
+
+	if (FreeGameEventStringIDs.Num() > 0)
+	{
+		newID = FreeGameEventStringIDs.Pop(false);
+
+		GameEventStrings[newID] = text;
+		GameEventStringReferences[newID] = 0;
+	}
+	else
+	{
+		newID = GameEventStrings.Emplace(text);
+
+		GameEventStringReferences.Emplace(0);
+	}
+
+	GameEventStringIDs.Emplace(text, newID);
 
-	GameEvents.Emplace(gameEvent);
+	return newID;
+}
+
+/**
+* Release a reference to an interned game event string, freeing it when none remain.
+***********************************************************************************/
+
+void APlayGameMode::ReleaseGameEventString(int32 id)
+{
+	if (GameEventStrings.IsValidIndex(id) == true &&
+		--GameEventStringReferences[id] <= 0)
+	{
+		GameEventStringIDs.Remove(GameEventStrings[id]);
+		GameEventStrings[id].Empty();
+		GameEventStringReferences[id] = 0;
+		FreeGameEventStringIDs.Emplace(id);
+	}
 }
 
 /**
@@ -716,7 +2077,191 @@ float APlayGameMode::MasterRacingSplineDistanceToLapDistance(float distance)
 
 bool APlayGameMode::ProjectWorldLocationToWidgetPosition(APawn* pawn, FVector worldLocation, FVector2D& screenPosition, FMinimalViewInfo* cachedView)
 {
-	return false;
+	int32 localPlayerIndex = GetLocalPlayerIndex(pawn);
+
+	if (localPlayerIndex < 0)
+	{
+		return false;
+	}
+
+	const FHUDProjectionContext& context = GetHUDProjectionContext(localPlayerIndex);
+
+	if (context.Valid == false)
+	{
+		return false;
+	}
+
+	FMathEx::OutCode outCode = FMathEx::OutCodeInside;
+
+	if (cachedView != nullptr)
+	{
+		// A view supplied by the caller replaces the player's view, but it still
+		// renders into the player's viewport.
+
+		FMatrix viewMatrix;
+		FMatrix projectionMatrix;
+		FMatrix viewProjectionMatrix;
+		FHUDProjectionContext viewContext;
+
+		UGameplayStatics::GetViewProjectionMatrix(*cachedView, viewMatrix, projectionMatrix, viewProjectionMatrix);
+
+		BuildHUDProjectionContext(viewContext, viewProjectionMatrix, cachedView->Location, context.ViewportSize);
+
+		ProjectWorldLocationsToWidgetPositions(viewContext, &worldLocation, 1, &screenPosition, &outCode);
+	}
+	else
+	{
+		ProjectWorldLocationsToWidgetPositions(context, &worldLocation, 1, &screenPosition, &outCode);
+	}
+
+	return ((outCode & FMathEx::OutCodeBehind) == 0);
+}
+
+/**
+* Project a batch of points in world space for use on the HUD, returning the number
+* that are on-screen.
+*
+* Each point is given an outcode against the widget rectangle for the viewport, so
+* that callers can feed the results straight into the line clipper. Points behind
+* the view are pushed off the edge of the viewport in the direction that they lie,
+* and flagged with OutCodeBehind, which is what the off-screen indicators need.
+***********************************************************************************/
+
+int32 APlayGameMode::ProjectWorldLocationsToWidgetPositions(const FHUDProjectionContext& context, const FVector* worldLocations, int32 numLocations, FVector2D* screenPositions, FMathEx::OutCode* outCodes) const
+{
+	int32 numOnScreen = 0;
+	FVector2D halfSize = context.WidgetRectangle.Max * 0.5f;
+	float offScreen = halfSize.Size() * 2.0f;
+	FVector4 clip;
+
+	for (int32 i = 0; i < numLocations; i++)
+	{
+		FMathEx::OutCode outCode = FMathEx::OutCodeBehind;
+
+		if (context.Valid == true)
+		{
+			// Transform into clip space with the vector unit, one point per register.
+
+			VectorRegister location = VectorLoadFloat3_W1(&worldLocations[i]);
+
+			VectorStoreAligned(VectorTransformVector(location, &context.ViewProjectionMatrix), &clip);
+
+			if (clip.W > KINDA_SMALL_NUMBER)
+			{
+				float rhw = 1.0f / clip.W;
+
+				screenPositions[i] = FVector2D((1.0f + clip.X * rhw) * halfSize.X, (1.0f - clip.Y * rhw) * halfSize.Y);
+
+				outCode = FMathEx::ComputeOutCode(screenPositions[i], context.WidgetRectangle);
+			}
+			else
+			{
+				screenPositions[i] = halfSize + FVector2D(clip.X, -clip.Y).GetSafeNormal() * offScreen;
+
+				outCode = FMathEx::ComputeOutCode(screenPositions[i], context.WidgetRectangle) | FMathEx::OutCodeBehind;
+			}
+		}
+		else
+		{
+			screenPositions[i] = FVector2D::ZeroVector;
+		}
+
+		if (outCode == FMathEx::OutCodeInside)
+		{
+			numOnScreen++;
+		}
+
+		if (outCodes != nullptr)
+		{
+			outCodes[i] = outCode;
+		}
+	}
+
+	return numOnScreen;
+}
+
+/**
+* Get the projection context for a local player, building it if it's not current.
+*
+* This is normally first called when the HUD is updated, by which time the player
+* camera managers have all been updated for the frame.
+***********************************************************************************/
+
+const FHUDProjectionContext& APlayGameMode::GetHUDProjectionContext(int32 localPlayerIndex)
+{
+	static FHUDProjectionContext invalidContext;
+
+	if (localPlayerIndex < 0 ||
+		localPlayerIndex >= GRIP_MAX_LOCAL_PLAYERS)
+	{
+		return invalidContext;
+	}
+
+	FHUDProjectionContext& context = HUDProjectionContexts[localPlayerIndex];
+
+	if (context.FrameNumber != FrameNumber)
+	{
+		context.FrameNumber = FrameNumber;
+		context.Valid = false;
+
+		APlayerController* controller = UGameplayStatics::GetPlayerController(this, localPlayerIndex);
+		ULocalPlayer* localPlayer = (controller != nullptr) ? controller->GetLocalPlayer() : nullptr;
+
+		if (localPlayer != nullptr &&
+			localPlayer->ViewportClient != nullptr)
+		{
+			FSceneViewProjectionData projectionData;
+
+			if (localPlayer->GetProjectionData(localPlayer->ViewportClient->Viewport, eSSP_FULL, projectionData) == true)
+			{
+				FIntRect viewRect = projectionData.GetConstrainedViewRect();
+
+				BuildHUDProjectionContext(context, projectionData.ComputeViewProjectionMatrix(), projectionData.ViewOrigin, FVector2D(viewRect.Width(), viewRect.Height()));
+			}
+		}
+	}
+
+	return context;
+}
+
+/**
+* Build a projection context from a view and the size of its viewport.
+***********************************************************************************/
+
+void APlayGameMode::BuildHUDProjectionContext(FHUDProjectionContext& context, const FMatrix& viewProjectionMatrix, const FVector& viewLocation, const FVector2D& viewportSize) const
+{
+	context.ViewProjectionMatrix = viewProjectionMatrix;
+	context.ViewLocation = viewLocation;
+	context.ViewportSize = viewportSize;
+	context.DPIScale = FMath::Max(UWidgetLayoutLibrary::GetViewportScale(this), KINDA_SMALL_NUMBER);
+	context.WidgetRectangle.Min = FVector2D::ZeroVector;
+	context.WidgetRectangle.Max = viewportSize / context.DPIScale;
+	context.Valid = (viewportSize.X > 0.0f && viewportSize.Y > 0.0f);
+}
+
+/**
+* Get the index of the local player that controls a pawn, or -1 if none.
+***********************************************************************************/
+
+int32 APlayGameMode::GetLocalPlayerIndex(APawn* pawn) const
+{
+	if (pawn != nullptr)
+	{
+		AController* pawnController = pawn->GetController();
+
+		if (pawnController != nullptr)
+		{
+			for (int32 i = 0; i < GRIP_MAX_LOCAL_PLAYERS; i++)
+			{
+				if (UGameplayStatics::GetPlayerController(this, i) == pawnController)
+				{
+					return i;
+				}
+			}
+		}
+	}
+
+	return -1;
 }
 
 /**
@@ -725,6 +2270,16 @@ bool APlayGameMode::ProjectWorldLocationToWidgetPosition(APawn* pawn, FVector wo
 ***********************************************************************************/
 
 FDifficultyCharacteristics& APlayGameMode::GetDifficultyCharacteristics(int32 level)
+{
+	return const_cast<FDifficultyCharacteristics&>(static_cast<const APlayGameMode*>(this)->GetDifficultyCharacteristics(level));
+}
+
+/**
+* Get the difficulty characteristics for a given level, or the current level if -1
+* is passed.
+***********************************************************************************/
+
+const FDifficultyCharacteristics& APlayGameMode::GetDifficultyCharacteristics(int32 level) const
 {
 	if (level < 0)
 	{
@@ -15,6 +15,7 @@
 #include "vehicle/flippablevehicle.h"
 #include "ui/hudwidget.h"
 #include "gamemodes/basegamemode.h"
+#include "gamemodes/playgamemode.h"
 
 /**
 * Construct a UGunHostInterface.
@@ -38,3 +39,22 @@ AGatlingGun::AGatlingGun()
 
 	SetRootComponent(BarrelSpinAudio);
 }
+
+/**
+* Fire a round from the gun, queuing it for hit testing with the other rounds fired
+* this frame.
+*
+* Returns false if too many rounds are already waiting and this one was dropped.
+***********************************************************************************/
+
+bool AGatlingGun::FireRound(const FVector& start, const FVector& direction, bool charged)
+{
+	APlayGameMode* gameMode = APlayGameMode::Get(this);
+
+	if (gameMode == nullptr)
+	{
+		return false;
+	}
+
+	return gameMode->GetGunRoundManager().QueueRound(this, start, direction, charged);
+}
@@ -0,0 +1,332 @@
+/**
+*
+* Gun round manager.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Hit testing and impact effects for all of the rounds fired by Gatling guns in the
+* game. Rounds fired during a frame are queued and submitted together as async
+* traces, and their hits are resolved on the next frame into a small pool of
+* impact effects, with hits close together on the same surface merged into one.
+* The cost per frame is bounded however many guns are firing.
+*
+***********************************************************************************/
+
+#include "pickups/gunroundmanager.h"
+#include "pickups/gatlinggun.h"
+#include "gamemodes/basegamemode.h"
+#include "vehicle/flippablevehicle.h"
+#include "physicalmaterials/physicalmaterial.h"
+
+const float FGunRoundManager::RoundRange = 500.0f * 100.0f;
+const float FGunRoundManager::MergeDistance = 2.0f * 100.0f;
+
+/**
+* Queue a round for hit testing, returning false if the queue is full and the round
+* was dropped.
+***********************************************************************************/
+
+bool FGunRoundManager::QueueRound(AGatlingGun* gun, const FVector& start, const FVector& direction, bool charged)
+{
+	if (QueuedRounds.Num() >= MaxQueuedRounds)
+	{
+		return false;
+	}
+
+	FGunRound& round = QueuedRounds[QueuedRounds.AddDefaulted()];
+
+	round.Gun = gun;
+	round.Start = start;
+	round.End = start + (direction.GetSafeNormal() * RoundRange);
+	round.Charged = charged;
+
+	return true;
+}
+
+/**
+* Resolve the hits from the last frame into impact effects and submit the rounds
+* queued since.
+***********************************************************************************/
+
+void FGunRoundManager::Tick(UWorld* world, AActor* owner)
+{
+	// Resolve last frame's traces into this frame's impacts.
+
+	int32 numImpacts = 0;
+
+	for (int32 i = 0; i < SubmittedTraces.Num(); i++)
+	{
+		FTraceDatum datum;
+
+		if (world->QueryTraceData(SubmittedTraces[i], datum) == true)
+		{
+			for (const FHitResult& hit : datum.OutHits)
+			{
+				if (hit.bBlockingHit == true)
+				{
+					MergeHit(SubmittedRounds[i], hit, numImpacts);
+					break;
+				}
+			}
+		}
+	}
+
+	for (int32 i = 0; i < numImpacts; i++)
+	{
+		StartImpactEffect(world, owner, Impacts[i]);
+	}
+
+	// Submit as many of the queued rounds as the frame budget allows, oldest first,
+	// leaving the rest for the next frame.
+
+	int32 numRounds = FMath::Min(QueuedRounds.Num(), MaxRoundsPerFrame);
+
+	SubmittedRounds.Reset();
+	SubmittedTraces.Reset();
+
+	if (numRounds > 0)
+	{
+		FCollisionQueryParams queryParams(TEXT("GunRound"), false);
+
+		queryParams.bReturnPhysicalMaterial = true;
+
+		for (int32 i = 0; i < numRounds; i++)
+		{
+			const FGunRound& round = QueuedRounds[i];
+			AGatlingGun* gun = round.Gun.Get();
+
+			queryParams.ClearIgnoredActors();
+
+			if (gun != nullptr &&
+				gun->GetOwner() != nullptr)
+			{
+				queryParams.AddIgnoredActor(gun->GetOwner());
+			}
+
+			SubmittedRounds.Emplace(round);
+			SubmittedTraces.Emplace(world->AsyncLineTraceByChannel(EAsyncTraceType::Single, round.Start, round.End, ABaseGameMode::ECC_LineOfSightTestIncVehicles, queryParams));
+		}
+
+		QueuedRounds.RemoveAt(0, numRounds, false);
+	}
+}
+
+/**
+* Remove all of the rounds and effects.
+***********************************************************************************/
+
+void FGunRoundManager::Empty()
+{
+	QueuedRounds.Empty();
+	SubmittedRounds.Empty();
+	SubmittedTraces.Empty();
+	Impacts.Empty();
+	ImpactEffects.Empty();
+
+	NextSteal = 0;
+}
+
+/**
+* Merge a hit into this frame's impacts, starting a new impact if it's not near an
+* existing one.
+*
+* Once the impacts for the frame are exhausted the hit is merged into the nearest
+* existing impact on the same component instead, or discarded.
+***********************************************************************************/
+
+void FGunRoundManager::MergeHit(const FGunRound& round, const FHitResult& hit, int32& numImpacts)
+{
+	UPrimitiveComponent* component = hit.GetComponent();
+	EGameSurface surface = (EGameSurface)UPhysicalMaterial::DetermineSurfaceType(hit.PhysMaterial.Get());
+	FGunImpact* nearest = nullptr;
+	float nearestDistance = 0.0f;
+
+	for (int32 i = 0; i < numImpacts; i++)
+	{
+		FGunImpact& impact = Impacts[i];
+
+		if (impact.Component == component &&
+			impact.Surface == surface)
+		{
+			float distance = FVector::DistSquared(impact.Location, hit.ImpactPoint);
+
+			if (nearest == nullptr ||
+				nearestDistance > distance)
+			{
+				nearest = &impact;
+				nearestDistance = distance;
+			}
+		}
+	}
+
+	if (nearest == nullptr ||
+		nearestDistance > FMath::Square(MergeDistance))
+	{
+		if (numImpacts < MaxImpactsPerFrame)
+		{
+			if (Impacts.Num() <= numImpacts)
+			{
+				Impacts.AddDefaulted();
+			}
+
+			FGunImpact& impact = Impacts[numImpacts++];
+
+			impact.Gun = round.Gun;
+			impact.Component = component;
+			impact.Surface = surface;
+			impact.Location = hit.ImpactPoint;
+			impact.Normal = hit.ImpactNormal;
+			impact.Charged = round.Charged;
+			impact.HitLocations.Reset();
+			impact.HitLocations.Emplace(hit.ImpactPoint);
+
+			return;
+		}
+		else if (nearest == nullptr)
+		{
+			return;
+		}
+	}
+
+	nearest->Charged |= round.Charged;
+	nearest->HitLocations.Emplace(hit.ImpactPoint);
+}
+
+/**
+* Start the effect for an impact.
+*
+* Guns with their own ImpactEffects or ImpactSound have those started here from the
+* pool. Anything not covered by them falls back to the launching vehicle's surface
+* impact characteristics, which are passed on to the blueprint to spawn as before.
+***********************************************************************************/
+
+void FGunRoundManager::StartImpactEffect(UWorld* world, AActor* owner, FGunImpact& impact)
+{
+	AGatlingGun* gun = impact.Gun.Get();
+
+	if (gun == nullptr)
+	{
+		return;
+	}
+
+	FRotator rotation = impact.Normal.Rotation();
+	UParticleSystem** emitterTemplate = gun->ImpactEffects.Find(impact.Surface);
+
+	if (emitterTemplate == nullptr)
+	{
+		emitterTemplate = gun->ImpactEffects.Find(EGameSurface::Default);
+	}
+
+	bool pooledEffect = (emitterTemplate != nullptr && *emitterTemplate != nullptr);
+
+	if (pooledEffect == true)
+	{
+		UParticleSystemComponent* component = GetPooledImpactEffect(owner, *emitterTemplate);
+
+		component->SetWorldLocationAndRotation(impact.Location, rotation);
+
+		if (component->IsRegistered() == false)
+		{
+			component->RegisterComponent();
+		}
+
+		component->ActivateSystem(true);
+	}
+
+	if (gun->ImpactSound != nullptr)
+	{
+		UGameplayStatics::PlaySoundAtLocation(world, gun->ImpactSound, impact.Location);
+	}
+
+	// Hand whatever hasn't been started from the pool to the blueprint, taken from
+	// the launching vehicle's surface impact characteristics.
+
+	TArray<UParticleSystem*> particleSystems;
+	USoundCue* soundEffect = nullptr;
+
+	if (gun->LaunchVehicleIsValid() == true &&
+		gun->GetLaunchVehicle()->DrivingSurfaceImpactCharacteristics != nullptr)
+	{
+		const TArray<FDrivingSurfaceImpact>& surfaces = gun->GetLaunchVehicle()->DrivingSurfaceImpactCharacteristics->Surfaces;
+		const FDrivingSurfaceImpact* surface = surfaces.FindByKey(impact.Surface);
+
+		if (surface == nullptr)
+		{
+			surface = surfaces.FindByKey(EGameSurface::Default);
+		}
+
+		if (surface != nullptr)
+		{
+			if (pooledEffect == false &&
+				surface->BodyEffect != nullptr)
+			{
+				particleSystems.Emplace(surface->BodyEffect);
+			}
+
+			if (gun->ImpactSound == nullptr)
+			{
+				soundEffect = surface->BodySound;
+			}
+		}
+	}
+
+	UGlobalGameState* gameState = UGlobalGameState::GetGlobalGameState(world->GetGameInstance(), false);
+	FVector colour = (gameState != nullptr) ? gameState->MapSurfaceColor : FVector::OneVector;
+
+	gun->BulletHitAnimation(impact.Component.Get(), particleSystems, impact.HitLocations, soundEffect, impact.Location, rotation, impact.Surface, colour, impact.Charged);
+}
+
+/**
+* Get an impact effect component from the pool for a template.
+*
+* A component is free for reuse once its system has completed. If none are free and
+* the pool is full then the one that was started longest ago is restarted.
+***********************************************************************************/
+
+UParticleSystemComponent* FGunRoundManager::GetPooledImpactEffect(AActor* owner, UParticleSystem* emitterTemplate)
+{
+	UParticleSystemComponent* component = nullptr;
+
+	for (UParticleSystemComponent* pooled : ImpactEffects)
+	{
+		if (pooled->IsActive() == false)
+		{
+			component = pooled;
+			break;
+		}
+	}
+
+	if (component == nullptr)
+	{
+		if (ImpactEffects.Num() >= MaxPooledImpactEffects)
+		{
+			component = ImpactEffects[NextSteal];
+
+			NextSteal = (NextSteal + 1) % ImpactEffects.Num();
+
+			component->DeactivateImmediate();
+		}
+		else
+		{
+			component = NewObject<UParticleSystemComponent>(owner);
+
+			component->bAutoDestroy = false;
+			component->bAllowAnyoneToDestroyMe = false;
+			component->SecondsBeforeInactive = 0.0f;
+			component->bAutoActivate = false;
+			component->bOverrideLODMethod = false;
+
+			ImpactEffects.Emplace(component);
+		}
+	}
+
+	if (component->Template != emitterTemplate)
+	{
+		component->SetTemplate(emitterTemplate);
+	}
+
+	return component;
+}
@@ -14,6 +14,7 @@
 #include "pickups/homingmissile.h"
 #include "vehicle/flippablevehicle.h"
 #include "gamemodes/basegamemode.h"
+#include "gamemodes/playgamemode.h"
 
 /**
 * Construct a UMissileHostInterface.
@@ -61,3 +62,88 @@ AHomingMissile::AHomingMissile()
 
 	PrimaryActorTick.bCanEverTick = true;
 }
+
+/**
+* Reset the state of the missile as it's taken from an actor pool, ready for reuse.
+*
+* The missile may have been returned to the pool mid-flight, so it's dropped from
+* the missile manager too, which holds its age and simulated movement.
+***********************************************************************************/
+
+void AHomingMissile::ResetForPool()
+{
+	Super::ResetForPool();
+
+	Target = nullptr;
+
+	APlayGameMode* gameMode = APlayGameMode::Get(this);
+
+	if (gameMode != nullptr)
+	{
+		gameMode->RemoveMissile(this);
+	}
+
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+
+	if (MissileMovement != nullptr)
+	{
+		MissileMovement->HomingTargetComponent = nullptr;
+		MissileMovement->Velocity = FVector::ZeroVector;
+	}
+
+	if (RocketAudio != nullptr)
+	{
+		RocketAudio->Stop();
+		RocketAudio = nullptr;
+	}
+
+	RocketTrail->SetHiddenInGame(true);
+	RocketLight->SetHiddenInGame(true);
+}
+
+/**
+* Explode the missile, from a blocking hit, its proximity fuse or its rocket running
+* out.
+***********************************************************************************/
+
+void AHomingMissile::Explode_Implementation(const FHitResult& hit)
+{
+	FVector location = (hit.bBlockingHit == true) ? FVector(hit.ImpactPoint) : GetActorLocation();
+
+	if (ExplosionVisual != nullptr)
+	{
+		UGameplayStatics::SpawnEmitterAtLocation(this, ExplosionVisual, location, GetActorRotation());
+	}
+
+	USoundCue* sound = ExplosionSound;
+	IMissileHostInterface* host = Cast<IMissileHostInterface>(LaunchVehicle);
+
+	if (host != nullptr &&
+		host->UseHumanPlayerAudio() == false &&
+		ExplosionSoundNonPlayer != nullptr)
+	{
+		sound = ExplosionSoundNonPlayer;
+	}
+
+	if (sound != nullptr)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, sound, location);
+	}
+
+	if (ExplosionForce != nullptr)
+	{
+		ExplosionForce->FireImpulse();
+	}
+
+	APlayGameMode* gameMode = APlayGameMode::Get(this);
+
+	if (gameMode != nullptr)
+	{
+		gameMode->RemoveMissile(this);
+		gameMode->ReleasePooledActor(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
@@ -0,0 +1,391 @@
+/**
+*
+* Missile manager.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Advances all of the homing missiles in the game in a single pass, rather than
+* each missile having its own movement component do the work. The state for the
+* missiles is held as separate arrays, terrain following is from baked ground
+* offsets on missile assistance splines where available and batched asynchronous
+* traces elsewhere, and the closest threatening missile for each vehicle drops out
+* of the same pass.
+*
+***********************************************************************************/
+
+#include "pickups/missilemanager.h"
+#include "pickups/homingmissile.h"
+#include "vehicle/basevehicle.h"
+#include "ai/pursuitsplineactor.h"
+#include "gamemodes/basegamemode.h"
+#include "algo/binarysearch.h"
+
+const float FMissileManager::TerrainClearance = 3.0f * 100.0f;
+const float FMissileManager::TerrainProbeLength = 20.0f * 100.0f;
+const float FMissileManager::AssistanceSplineRange = 50.0f * 100.0f;
+const float FMissileManager::WarningTime = 3.0f;
+
+/**
+* Add a missile to be simulated, taking over from its own movement component.
+***********************************************************************************/
+
+void FMissileManager::AddMissile(AHomingMissile* missile, const FVector& velocity)
+{
+	if (missile == nullptr ||
+		Missiles.Contains(missile) == true)
+	{
+		return;
+	}
+
+	if (missile->MissileMovement != nullptr)
+	{
+		missile->MissileMovement->SetComponentTickEnabled(false);
+	}
+
+	Missiles.Emplace(missile);
+	Locations.Emplace(missile->GetActorLocation());
+	Velocities.Emplace(velocity);
+	Ages.Emplace(0.0f);
+	GroundOffsets.Emplace(FVector::ZeroVector);
+	TerrainTraces.Emplace(FTraceHandle());
+	AssistanceSplineIndices.Emplace(INDEX_NONE);
+	AssistanceSplineDistances.Emplace(-1.0f);
+}
+
+/**
+* Remove a missile from being simulated.
+***********************************************************************************/
+
+void FMissileManager::RemoveMissile(AHomingMissile* missile)
+{
+	int32 index = Missiles.Find(missile);
+
+	if (index != INDEX_NONE)
+	{
+		Missiles.RemoveAtSwap(index, 1, false);
+		Locations.RemoveAtSwap(index, 1, false);
+		Velocities.RemoveAtSwap(index, 1, false);
+		Ages.RemoveAtSwap(index, 1, false);
+		GroundOffsets.RemoveAtSwap(index, 1, false);
+		TerrainTraces.RemoveAtSwap(index, 1, false);
+		AssistanceSplineIndices.RemoveAtSwap(index, 1, false);
+		AssistanceSplineDistances.RemoveAtSwap(index, 1, false);
+	}
+}
+
+/**
+* Add a missile assistance spline to take baked ground offsets from.
+***********************************************************************************/
+
+void FMissileManager::AddAssistanceSpline(UPursuitSplineComponent* spline)
+{
+	if (spline != nullptr &&
+		spline->Type == EPursuitSplineType::MissileAssistance)
+	{
+		AssistanceSplines.AddUnique(spline);
+	}
+}
+
+/**
+* Advance all of the missiles and determine the closest threat to each vehicle.
+***********************************************************************************/
+
+void FMissileManager::Tick(UWorld* world, float deltaSeconds)
+{
+	for (FMissileThreat& threat : Threats)
+	{
+		threat = FMissileThreat();
+	}
+
+	// Drop any missiles that have been destroyed from under us.
+
+	for (int32 i = Missiles.Num() - 1; i >= 0; i--)
+	{
+		if (GRIP_OBJECT_VALID(Missiles[i]) == false)
+		{
+			RemoveMissile(Missiles[i]);
+		}
+	}
+
+	if (Missiles.Num() == 0 ||
+		deltaSeconds <= 0.0f)
+	{
+		return;
+	}
+
+	ConsumeTerrainTraces(world);
+
+	FCollisionQueryParams queryParams(TEXT("MissileTerrain"), false);
+	TArray<TPair<AHomingMissile*, FHitResult>, TInlineAllocator<8>> explosions;
+
+	for (int32 i = 0; i < Missiles.Num(); i++)
+	{
+		AHomingMissile* missile = Missiles[i];
+		UMissileMovementComponent* movement = missile->MissileMovement;
+		FVector& location = Locations[i];
+		FVector& velocity = Velocities[i];
+		float speed = velocity.Size();
+		FVector direction = (speed > KINDA_SMALL_NUMBER) ? velocity / speed : missile->GetActorForwardVector();
+		float maxSpeed = FMathEx::KilometersPerHourToCentimetersPerSecond(movement->MaximumSpeed);
+		float speedRatio = (maxSpeed > 0.0f) ? FMath::Min(speed / maxSpeed, 1.0f) : 1.0f;
+
+		Ages[i] += deltaSeconds;
+
+		// Explode when the rocket runs out, or when within the proximity fuse of the target.
+
+		if (Ages[i] > missile->RocketDuration ||
+			(GRIP_OBJECT_VALID(missile->Target) == true &&
+			FVector::DistSquared(missile->Target->GetActorLocation(), location) < FMath::Square(missile->ProximityFuse)))
+		{
+			explosions.Emplace(missile, FHitResult());
+			continue;
+		}
+
+		// Accelerate up to the maximum speed.
+
+		if (maxSpeed > 0.0f &&
+			movement->AccelerationTime > 0.0f)
+		{
+			speed = FMath::Min(speed + ((maxSpeed / movement->AccelerationTime) * deltaSeconds), maxSpeed);
+		}
+
+		// Turn towards the target, at a rate that reduces with speed.
+
+		AActor* target = missile->Target;
+
+		if (GRIP_OBJECT_VALID(target) == true)
+		{
+			FVector toTarget = (target->GetActorLocation() - location).GetSafeNormal();
+			float dotProduct = FVector::DotProduct(direction, toTarget);
+
+			if (missile->LoseLockOnRear == true &&
+				dotProduct < 0.0f)
+			{
+				missile->Target = nullptr;
+			}
+			else
+			{
+				float angle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(dotProduct, -1.0f, 1.0f)));
+				float maxAngle = FMath::Lerp(movement->StartSpeedTurnRate, movement->TopSpeedTurnRate, speedRatio) * deltaSeconds;
+
+				if (angle > KINDA_SMALL_NUMBER)
+				{
+					FQuat turn = FQuat::Slerp(FQuat::Identity, FQuat::FindBetweenNormals(direction, toTarget), FMath::Min(maxAngle / angle, 1.0f));
+
+					direction = turn.RotateVector(direction);
+				}
+			}
+		}
+
+		// Follow the terrain, pushing away from the ground when inside the clearance.
+
+		FVector groundOffset = FVector::ZeroVector;
+
+		if (GetBakedGroundOffset(i, groundOffset) == false)
+		{
+			groundOffset = GroundOffsets[i];
+
+			if (TerrainTraces[i].IsValid() == false)
+			{
+				queryParams.ClearIgnoredActors();
+				queryParams.AddIgnoredActor(missile);
+
+				TerrainTraces[i] = world->AsyncLineTraceByChannel(EAsyncTraceType::Single, location, location - (FVector::UpVector * TerrainProbeLength), ABaseGameMode::ECC_LineOfSightTest, queryParams);
+			}
+		}
+
+		float groundDistance = groundOffset.Size();
+
+		if (groundDistance > KINDA_SMALL_NUMBER &&
+			groundDistance < TerrainClearance)
+		{
+			direction = (direction - ((groundOffset / groundDistance) * (1.0f - (groundDistance / TerrainClearance)))).GetSafeNormal();
+		}
+
+		velocity = direction * speed;
+
+		// Sweep the missile to its new location so that it can't pass through anything,
+		// and explode it on whatever it hits. The sweep dispatches the hit to the missile
+		// too, just as its movement component would have done.
+
+		FHitResult hit;
+
+		missile->SetActorLocationAndRotation(location + (velocity * deltaSeconds), direction.Rotation(), true, &hit);
+
+		location = missile->GetActorLocation();
+
+		if (hit.bBlockingHit == true)
+		{
+			explosions.Emplace(missile, hit);
+		}
+	}
+
+	// Each missile only has one target, so finding the closest threat to each vehicle
+	// is a single pass over the missiles rather than every vehicle scanning them all.
+
+	for (int32 i = 0; i < Missiles.Num(); i++)
+	{
+		ABaseVehicle* vehicle = Cast<ABaseVehicle>(Missiles[i]->Target);
+
+		if (vehicle != nullptr &&
+			vehicle->VehicleIndex >= 0 &&
+			vehicle->VehicleIndex < GRIP_MAX_PLAYERS)
+		{
+			FMissileThreat& threat = Threats[vehicle->VehicleIndex];
+			FVector difference = vehicle->GetActorLocation() - Locations[i];
+			float distance = difference.Size();
+
+			if (threat.Missile == nullptr ||
+				threat.Distance > distance)
+			{
+				float closingSpeed = FVector::DotProduct(Velocities[i] - vehicle->GetVelocity(), difference.GetSafeNormal());
+
+				threat.Missile = Missiles[i];
+				threat.Distance = distance;
+				threat.TimeToImpact = (closingSpeed > KINDA_SMALL_NUMBER) ? distance / closingSpeed : BIG_NUMBER;
+				threat.WarningAmount = 1.0f - FMath::Min(threat.TimeToImpact / WarningTime, 1.0f);
+			}
+		}
+	}
+
+	// Explode missiles last, as that removes them from the arrays we've been iterating.
+
+	for (TPair<AHomingMissile*, FHitResult>& explosion : explosions)
+	{
+		RemoveMissile(explosion.Key);
+
+		explosion.Key->Explode(explosion.Value);
+	}
+}
+
+/**
+* Remove all of the missiles and splines.
+***********************************************************************************/
+
+void FMissileManager::Empty()
+{
+	Missiles.Empty();
+	AssistanceSplines.Empty();
+	Locations.Empty();
+	Velocities.Empty();
+	Ages.Empty();
+	GroundOffsets.Empty();
+	TerrainTraces.Empty();
+	AssistanceSplineIndices.Empty();
+	AssistanceSplineDistances.Empty();
+
+	for (FMissileThreat& threat : Threats)
+	{
+		threat = FMissileThreat();
+	}
+}
+
+/**
+* Consume the terrain traces that were issued on the last frame.
+***********************************************************************************/
+
+void FMissileManager::ConsumeTerrainTraces(UWorld* world)
+{
+	for (int32 i = 0; i < Missiles.Num(); i++)
+	{
+		FTraceHandle& handle = TerrainTraces[i];
+
+		if (handle.IsValid() == true)
+		{
+			FTraceDatum datum;
+
+			if (world->QueryTraceData(handle, datum) == true)
+			{
+				GroundOffsets[i] = FVector::ZeroVector;
+
+				for (const FHitResult& hit : datum.OutHits)
+				{
+					if (hit.bBlockingHit == true)
+					{
+						GroundOffsets[i] = hit.ImpactPoint - datum.Start;
+						break;
+					}
+				}
+
+				handle.Invalidate();
+			}
+			else if (world->IsTraceHandleValid(handle, false) == false)
+			{
+				handle.Invalidate();
+			}
+		}
+	}
+}
+
+/**
+* Get the baked ground offset for a missile from the nearest missile assistance
+* spline, returning false if there isn't one.
+***********************************************************************************/
+
+bool FMissileManager::GetBakedGroundOffset(int32 index, FVector& groundOffset)
+{
+	const FVector& location = Locations[index];
+	int32& splineIndex = AssistanceSplineIndices[index];
+	float& splineDistance = AssistanceSplineDistances[index];
+
+	// Stay with the spline we were last near if we still are, searching from where we
+	// were along it, otherwise look for another.
+
+	if (AssistanceSplines.IsValidIndex(splineIndex) == true)
+	{
+		UPursuitSplineComponent* spline = AssistanceSplines[splineIndex];
+
+		splineDistance = spline->GetNearestDistance(location, splineDistance, AssistanceSplineRange * 2.0f);
+
+		if (FVector::DistSquared(spline->GetLocationAtDistanceAlongSpline(splineDistance, ESplineCoordinateSpace::World), location) > FMath::Square(AssistanceSplineRange))
+		{
+			splineIndex = INDEX_NONE;
+		}
+	}
+
+	if (splineIndex == INDEX_NONE)
+	{
+		for (int32 i = 0; i < AssistanceSplines.Num(); i++)
+		{
+			UPursuitSplineComponent* spline = AssistanceSplines[i];
+
+			if (spline->Enabled == true)
+			{
+				float distance = spline->GetNearestDistance(location);
+
+				if (FVector::DistSquared(spline->GetLocationAtDistanceAlongSpline(distance, ESplineCoordinateSpace::World), location) < FMath::Square(AssistanceSplineRange))
+				{
+					splineIndex = i;
+					splineDistance = distance;
+					break;
+				}
+			}
+		}
+	}
+
+	if (splineIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	APursuitSplineActor* actor = Cast<APursuitSplineActor>(AssistanceSplines[splineIndex]->GetOwner());
+
+	if (actor == nullptr ||
+		actor->PointExtendedData.Num() == 0)
+	{
+		return false;
+	}
+
+	// The ground offset is relative to the spline, so bring it to the missile.
+
+	const TArray<FPursuitPointExtendedData>& points = actor->PointExtendedData;
+	int32 point = FMath::Min(Algo::LowerBoundBy(points, splineDistance, [] (const FPursuitPointExtendedData& data) { return data.Distance; }), points.Num() - 1);
+	FVector ground = AssistanceSplines[splineIndex]->GetLocationAtDistanceAlongSpline(points[point].Distance, ESplineCoordinateSpace::World) + points[point].UseGroundOffset;
+
+	groundOffset = ground - location;
+
+	return true;
+}
@@ -14,3 +14,76 @@
 #include "pickups/pickupbase.h"
 #include "vehicle/basevehicle.h"
 #include "gamemodes/playgamemode.h"
+
+/**
+* Reset the state of the pickup as it's taken from an actor pool, ready for reuse.
+***********************************************************************************/
+
+void APickupBase::ResetForPool()
+{
+	LaunchVehicle = nullptr;
+}
+
+/**
+* Activate the pickup as it's taken from an actor pool.
+*
+* Only the components that were ticking when the pickup went into the pool are set
+* ticking again, as some have their ticks disabled deliberately, like the movement
+* of missiles that the missile manager simulates instead.
+***********************************************************************************/
+
+void APickupBase::ActivateFromPool()
+{
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	for (UActorComponent* component : PooledTickingComponents)
+	{
+		if (component != nullptr)
+		{
+			component->SetComponentTickEnabled(true);
+		}
+	}
+
+	PooledTickingComponents.Reset();
+
+	for (UActorComponent* component : GetComponents())
+	{
+		if (component->bAutoActivate == true)
+		{
+			component->Activate(true);
+		}
+	}
+}
+
+/**
+* Deactivate the pickup as it's returned to an actor pool.
+*
+* Components are deactivated too, so that any audio or particle systems stop rather
+* than running on, hidden, while the pickup is in the pool.
+***********************************************************************************/
+
+void APickupBase::DeactivateToPool()
+{
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	PooledTickingComponents.Reset();
+
+	for (UActorComponent* component : GetComponents())
+	{
+		if (component->IsComponentTickEnabled() == true)
+		{
+			PooledTickingComponents.Emplace(component);
+		}
+
+		component->Deactivate();
+		component->SetComponentTickEnabled(false);
+	}
+
+	LaunchVehicle = nullptr;
+}
@@ -0,0 +1,210 @@
+/**
+*
+* Actor pools.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Pools of actors of a single class, spawned up front and then activated and
+* deactivated as they're needed rather than being spawned and destroyed each time,
+* which causes hitches for actors with lots of components like the pickups.
+*
+***********************************************************************************/
+
+#include "system/actorpool.h"
+#include "pickups/pickupbase.h"
+
+DEFINE_LOG_CATEGORY(GripLogActorPools);
+
+/**
+* Spawn actors until the pool holds its capacity.
+***********************************************************************************/
+
+void FActorPool::Prewarm(UWorld* world)
+{
+	while (NumSpawned < Capacity)
+	{
+		AActor* actor = Spawn(world);
+
+		if (actor == nullptr)
+		{
+			break;
+		}
+
+		FreeActors.Emplace(actor);
+	}
+}
+
+/**
+* Acquire an actor from the pool at a transform, spawning a new one if the pool is
+* exhausted.
+***********************************************************************************/
+
+AActor* FActorPool::Acquire(UWorld* world, const FTransform& transform, AActor* owner, APawn* instigator)
+{
+	AActor* actor = nullptr;
+
+	// Actors may have been destroyed from under us, during level streaming for
+	// example, so skip any that are no longer valid.
+
+	while (actor == nullptr &&
+		FreeActors.Num() > 0)
+	{
+		actor = FreeActors.Pop(false);
+
+		if (GRIP_OBJECT_VALID(actor) == false)
+		{
+			actor = nullptr;
+			NumSpawned--;
+		}
+	}
+
+	if (actor == nullptr)
+	{
+		if (NumSpawned >= Capacity)
+		{
+			NumOverflows++;
+
+			UE_LOG(GripLogActorPools, Warning, TEXT("Actor pool for %s overflowed its capacity of %d, %d actors now in use"), *ActorClass->GetName(), Capacity, NumInUse + 1);
+		}
+
+		actor = Spawn(world);
+
+		if (actor == nullptr)
+		{
+			return nullptr;
+		}
+	}
+
+	NumInUse++;
+	NumAcquired++;
+	PeakInUse = FMath::Max(PeakInUse, NumInUse);
+
+	actor->SetOwner(owner);
+	actor->SetInstigator(instigator);
+	actor->SetActorTransform(transform, false, nullptr, ETeleportType::TeleportPhysics);
+
+	Activate(actor);
+
+	return actor;
+}
+
+/**
+* Return an actor to the pool.
+***********************************************************************************/
+
+void FActorPool::Release(AActor* actor)
+{
+	if (GRIP_OBJECT_VALID(actor) == true)
+	{
+		Deactivate(actor);
+
+		FreeActors.Emplace(actor);
+	}
+	else
+	{
+		NumSpawned--;
+	}
+
+	NumInUse = FMath::Max(NumInUse - 1, 0);
+}
+
+/**
+* Empty the pool, destroying all of the actors that are free.
+***********************************************************************************/
+
+void FActorPool::Empty()
+{
+	for (AActor* actor : FreeActors)
+	{
+		if (GRIP_OBJECT_VALID(actor) == true)
+		{
+			actor->Destroy();
+		}
+	}
+
+	FreeActors.Empty();
+
+	NumSpawned = NumInUse;
+}
+
+/**
+* Log the instrumentation for the pool.
+***********************************************************************************/
+
+void FActorPool::LogStatistics() const
+{
+	UE_LOG(GripLogActorPools, Log, TEXT("Actor pool for %s: capacity %d, spawned %d, in use %d, peak %d, acquired %d, overflows %d"), *ActorClass->GetName(), Capacity, NumSpawned, NumInUse, PeakInUse, NumAcquired, NumOverflows);
+}
+
+/**
+* Spawn a new actor for the pool, deactivated.
+***********************************************************************************/
+
+AActor* FActorPool::Spawn(UWorld* world)
+{
+	if (world == nullptr ||
+		ActorClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters spawnParams;
+
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AActor* actor = world->SpawnActor<AActor>(ActorClass, FTransform::Identity, spawnParams);
+
+	if (actor != nullptr)
+	{
+		NumSpawned++;
+
+		Deactivate(actor);
+	}
+
+	return actor;
+}
+
+/**
+* Activate an actor as it's taken from the pool.
+***********************************************************************************/
+
+void FActorPool::Activate(AActor* actor)
+{
+	APickupBase* pickup = Cast<APickupBase>(actor);
+
+	if (pickup != nullptr)
+	{
+		pickup->ResetForPool();
+		pickup->ActivateFromPool();
+	}
+	else
+	{
+		actor->SetActorHiddenInGame(false);
+		actor->SetActorEnableCollision(true);
+		actor->SetActorTickEnabled(true);
+	}
+}
+
+/**
+* Deactivate an actor as it's returned to the pool.
+***********************************************************************************/
+
+void FActorPool::Deactivate(AActor* actor)
+{
+	APickupBase* pickup = Cast<APickupBase>(actor);
+
+	if (pickup != nullptr)
+	{
+		pickup->DeactivateToPool();
+	}
+	else
+	{
+		actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+		actor->SetActorHiddenInGame(true);
+		actor->SetActorEnableCollision(false);
+		actor->SetActorTickEnabled(false);
+	}
+}
@@ -23,8 +23,28 @@ UPositionableInterface::UPositionableInterface(const FObjectInitializer& objectI
 {
 }
 
+/**
+* The directions of the rays in the coarse stage of a surface probe, the three axes
+* and the four diagonals of a cube, which traced outward along each direction and its
+* opposite covers all of the faces and corners.
+***********************************************************************************/
+
+const FVector IPositionableInterface::CoarseDirections[IPositionableInterface::NumCoarseRays] =
+{
+	FVector(1.0f, 0.0f, 0.0f),
+	FVector(0.0f, 1.0f, 0.0f),
+	FVector(0.0f, 0.0f, 1.0f),
+	FVector(1.0f, 1.0f, 1.0f).GetUnsafeNormal(),
+	FVector(1.0f, 1.0f, -1.0f).GetUnsafeNormal(),
+	FVector(1.0f, -1.0f, 1.0f).GetUnsafeNormal(),
+	FVector(-1.0f, 1.0f, 1.0f).GetUnsafeNormal()
+};
+
 /**
 * Determine the surface position / rotation for an actor.
+*
+* This is a synchronous, exhaustive search, used in the Editor. At run-time, use
+* RequestSurfacePosition instead so as not to stall the game thread.
 ***********************************************************************************/
 
 bool IPositionableInterface::DetermineSurfacePosition(FVector& position, FRotator& rotation, float radius, AActor* parent, ECollisionChannel channel, bool useRotation)
@@ -32,6 +52,8 @@ bool IPositionableInterface::DetermineSurfacePosition(FVector& position, FRotato
 	FHitResult minHit;
 	float minDistance = BIG_NUMBER;
 	const int32 iterations = 8;
+	UWorld* world = parent->GetWorld();
+	FCollisionQueryParams queryParams(TEXT("Positionable"), true, parent);
 
 	if (channel == ECC_MAX)
 	{
@@ -45,7 +67,7 @@ bool IPositionableInterface::DetermineSurfacePosition(FVector& position, FRotato
 		FVector start = position;
 		FVector end = position + (offset * radius);
 
-		if (parent->GetWorld()->LineTraceSingleByChannel(hit, start, end, channel, FCollisionQueryParams(TEXT("Positionable"), true, parent)) == true)
+		if (world->LineTraceSingleByChannel(hit, start, end, channel, queryParams) == true)
 		{
 			FVector difference = (hit.ImpactPoint - position);
 
@@ -65,7 +87,7 @@ bool IPositionableInterface::DetermineSurfacePosition(FVector& position, FRotato
 				FVector start = position - (offset * radius);
 				FVector end = position + (offset * radius);
 
-				if (parent->GetWorld()->LineTraceSingleByChannel(hit, start, end, channel, FCollisionQueryParams(TEXT("Positionable"), true, parent)) == true)
+				if (world->LineTraceSingleByChannel(hit, start, end, channel, queryParams) == true)
 				{
 					FVector difference = (hit.ImpactPoint - position);
 					float distance = difference.SizeSquared();
@@ -82,19 +104,194 @@ bool IPositionableInterface::DetermineSurfacePosition(FVector& position, FRotato
 
 	if (minDistance != BIG_NUMBER)
 	{
-		FQuat impactQuat = minHit.ImpactNormal.ToOrientationQuat();
-		FQuat newRotation = impactQuat * FQuat(FRotator(-90.0f, 0.0f, 0.0f));
+		ApplySurfaceHit(minHit, position, rotation);
+
+		return true;
+	}
+
+	return false;
+}
+
+/**
+* Request the surface position / rotation for an actor, which is returned in
+* OnSurfacePositionDetermined on a later frame.
+*
+* All of the rays for a stage are issued at once as asynchronous traces. A coarse
+* set of rays is traced first, and then a fine set in a cone around the nearest hit
+* found, unless that hit is already close enough to be used as is. This replaces the
+* 64 synchronous traces of DetermineSurfacePosition with 22 at most, none of which
+* block the game thread.
+*
+* Every ray starts at the position and is traced outward, as a single trace through
+* the position would only report its first hit, which may well not be the nearest.
+***********************************************************************************/
+
+bool IPositionableInterface::RequestSurfacePosition(const FVector& position, const FRotator& rotation, float radius, AActor* parent, ECollisionChannel channel)
+{
+	FSurfaceProbe& probe = GetSurfaceProbe();
+	UWorld* world = (parent != nullptr) ? parent->GetWorld() : nullptr;
+
+	if (world == nullptr)
+	{
+		return false;
+	}
+
+	if (channel == ECC_MAX)
+	{
+		channel = ABaseGameMode::ECC_LineOfSightTest;
+	}
+
+	// Bumping the generation orphans any traces still in flight for a previous probe.
+
+	probe.Generation++;
+	probe.Stage = FSurfaceProbe::EStage::Coarse;
+	probe.NumPending = 0;
+	probe.Position = position;
+	probe.Rotation = rotation;
+	probe.Radius = radius;
+	probe.Channel = channel;
+	probe.Parent = parent;
+	probe.MinDistance = BIG_NUMBER;
+
+	FCollisionQueryParams queryParams(TEXT("Positionable"), true, parent);
+
+	for (const FVector& direction : CoarseDirections)
+	{
+		IssueSurfaceTrace(world, position, position + (direction * radius), queryParams);
+		IssueSurfaceTrace(world, position, position - (direction * radius), queryParams);
+	}
+
+	return true;
+}
+
+/**
+* Issue an asynchronous trace for the current surface probe.
+***********************************************************************************/
+
+void IPositionableInterface::IssueSurfaceTrace(UWorld* world, const FVector& start, const FVector& end, const FCollisionQueryParams& queryParams)
+{
+	FSurfaceProbe& probe = GetSurfaceProbe();
+	FTraceDelegate delegate = FTraceDelegate::CreateWeakLambda(probe.Parent.Get(), [this] (const FTraceHandle& handle, FTraceDatum& datum)
+		{
+			OnSurfaceTrace(datum);
+		});
+
+	probe.NumPending++;
+
+	world->AsyncLineTraceByChannel(EAsyncTraceType::Single, start, end, probe.Channel, queryParams, FCollisionResponseParams::DefaultResponseParam, &delegate, probe.Generation);
+}
+
+/**
+* Handle the return of an asynchronous trace for the current surface probe.
+***********************************************************************************/
+
+void IPositionableInterface::OnSurfaceTrace(FTraceDatum& datum)
+{
+	FSurfaceProbe& probe = GetSurfaceProbe();
+
+	if (datum.UserData != probe.Generation ||
+		probe.Stage == FSurfaceProbe::EStage::Idle)
+	{
+		return;
+	}
 
-		if (FVector::DotProduct(newRotation.GetAxisZ(), rotation.Quaternion().GetAxisZ()) < 0.0f)
+	for (const FHitResult& hit : datum.OutHits)
+	{
+		if (hit.bBlockingHit == true)
 		{
-			newRotation = impactQuat * FQuat(FRotator(90.0f, 0.0f, 0.0f));
+			float distance = (hit.ImpactPoint - probe.Position).SizeSquared();
+
+			if (probe.MinDistance > distance)
+			{
+				probe.MinDistance = distance;
+				probe.MinHit = hit;
+			}
 		}
+	}
+
+	if (--probe.NumPending == 0)
+	{
+		AdvanceSurfaceProbe();
+	}
+}
+
+/**
+* Advance the current surface probe to its next stage once all of its traces have
+* returned.
+***********************************************************************************/
 
-		rotation = newRotation.Rotator();
-		position = minHit.ImpactPoint;
+void IPositionableInterface::AdvanceSurfaceProbe()
+{
+	FSurfaceProbe& probe = GetSurfaceProbe();
+	AActor* parent = probe.Parent.Get();
+	UWorld* world = (parent != nullptr) ? parent->GetWorld() : nullptr;
 
-		return true;
+	// Refine around the nearest coarse hit, unless it's close enough to the position
+	// already that refining wouldn't move it noticeably.
+
+	if (world != nullptr &&
+		probe.Stage == FSurfaceProbe::EStage::Coarse &&
+		probe.MinDistance != BIG_NUMBER &&
+		probe.MinDistance > FMath::Square(probe.Radius * 0.05f))
+	{
+		FVector direction = (probe.MinHit.ImpactPoint - probe.Position).GetSafeNormal();
+
+		if (direction.IsZero() == false)
+		{
+			FVector axis1;
+			FVector axis2;
+			FCollisionQueryParams queryParams(TEXT("Positionable"), true, parent);
+
+			direction.FindBestAxisVectors(axis1, axis2);
+
+			probe.Stage = FSurfaceProbe::EStage::Fine;
+
+			// A cone of rays at roughly half the angle between the coarse rays.
+
+			const float coneAngle = FMath::DegreesToRadians(27.5f);
+			float coneCos = FMath::Cos(coneAngle);
+			float coneSin = FMath::Sin(coneAngle);
+
+			for (int32 i = 0; i < NumFineRays; i++)
+			{
+				float angle = ((float)i / (float)NumFineRays) * PI * 2.0f;
+				FVector offset = (direction * coneCos) + (((axis1 * FMath::Cos(angle)) + (axis2 * FMath::Sin(angle))) * coneSin);
+
+				IssueSurfaceTrace(world, probe.Position, probe.Position + (offset * probe.Radius), queryParams);
+			}
+
+			return;
+		}
 	}
 
-	return false;
+	FVector position = probe.Position;
+	FRotator rotation = probe.Rotation;
+	bool found = (probe.MinDistance != BIG_NUMBER);
+
+	probe.Stage = FSurfaceProbe::EStage::Idle;
+
+	if (found == true)
+	{
+		ApplySurfaceHit(probe.MinHit, position, rotation);
+	}
+
+	OnSurfacePositionDetermined(found, position, rotation);
+}
+
+/**
+* Get the position / rotation for an actor from a surface hit.
+***********************************************************************************/
+
+void IPositionableInterface::ApplySurfaceHit(const FHitResult& hit, FVector& position, FRotator& rotation)
+{
+	FQuat impactQuat = hit.ImpactNormal.ToOrientationQuat();
+	FQuat newRotation = impactQuat * FQuat(FRotator(-90.0f, 0.0f, 0.0f));
+
+	if (FVector::DotProduct(newRotation.GetAxisZ(), rotation.Quaternion().GetAxisZ()) < 0.0f)
+	{
+		newRotation = impactQuat * FQuat(FRotator(90.0f, 0.0f, 0.0f));
+	}
+
+	rotation = newRotation.Rotator();
+	position = hit.ImpactPoint;
 }
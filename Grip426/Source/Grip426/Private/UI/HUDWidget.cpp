@@ -228,18 +228,18 @@ FText UHUDWidgetComponent::GetOutroPlacementText() const
 			position = vehicle->GetRaceState().RaceRank + 1;
 		}
 
+		// Disqualification is keyed as position 0, which is never a valid one-based position.
+
 		if (vehicle->GetRaceState().PlayerCompletionState == EPlayerCompletionState::Disqualified)
 		{
-			return NSLOCTEXT("GripScoreboard", "DNF", "DNF");
-		}
-		else
-		{
-			return GetEventPositionText(position, true);
+			position = 0;
 		}
+
+		return OutroPlacementText.Get(position, [position] () { return (position == 0) ? NSLOCTEXT("GripScoreboard", "DNF", "DNF") : GetEventPositionText(position, true); });
 	}
 	else
 	{
-		return FText::FromString("");
+		return FText::GetEmpty();
 	}
 }
 
@@ -249,9 +249,27 @@ FText UHUDWidgetComponent::GetOutroPlacementText() const
 
 FText UHUDWidgetComponent::GetEventPositionText(int32 position, bool oneBased)
 {
+	// The localized texts are created just the once, and track any change of culture
+	// by themselves.
+
+	static const FText notApplicable = NSLOCTEXT("GripScoreboard", "NA", "N/A");
+	static const FText positions[] =
+	{
+		NSLOCTEXT("GripScoreboard", "1st", "1st"),
+		NSLOCTEXT("GripScoreboard", "2nd", "2nd"),
+		NSLOCTEXT("GripScoreboard", "3rd", "3rd"),
+		NSLOCTEXT("GripScoreboard", "4th", "4th"),
+		NSLOCTEXT("GripScoreboard", "5th", "5th"),
+		NSLOCTEXT("GripScoreboard", "6th", "6th"),
+		NSLOCTEXT("GripScoreboard", "7th", "7th"),
+		NSLOCTEXT("GripScoreboard", "8th", "8th"),
+		NSLOCTEXT("GripScoreboard", "9th", "9th"),
+		NSLOCTEXT("GripScoreboard", "10th", "10th")
+	};
+
 	if (position < 0)
 	{
-		return NSLOCTEXT("GripScoreboard", "NA", "N/A");
+		return notApplicable;
 	}
 	else
 	{
@@ -260,32 +278,61 @@ FText UHUDWidgetComponent::GetEventPositionText(int32 position, bool oneBased)
 			position++;
 		}
 
-		switch (position)
+		if (position >= 1 &&
+			position <= (int32)GRIP_NUM_ELEMENTS(positions))
 		{
-		case 1:
-			return NSLOCTEXT("GripScoreboard", "1st", "1st");
-		case 2:
-			return NSLOCTEXT("GripScoreboard", "2nd", "2nd");
-		case 3:
-			return NSLOCTEXT("GripScoreboard", "3rd", "3rd");
-		case 4:
-			return NSLOCTEXT("GripScoreboard", "4th", "4th");
-		case 5:
-			return NSLOCTEXT("GripScoreboard", "5th", "5th");
-		case 6:
-			return NSLOCTEXT("GripScoreboard", "6th", "6th");
-		case 7:
-			return NSLOCTEXT("GripScoreboard", "7th", "7th");
-		case 8:
-			return NSLOCTEXT("GripScoreboard", "8th", "8th");
-		case 9:
-			return NSLOCTEXT("GripScoreboard", "9th", "9th");
-		case 10:
-			return NSLOCTEXT("GripScoreboard", "10th", "10th");
+			return positions[position - 1];
 		}
 
-		return FText::FromString("");
+		return FText::GetEmpty();
+	}
+}
+
+/**
+* Get the speedo text.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetSpeedoText() const
+{
+	return GetSpeedoText(0, SpeedoText);
+}
+
+/**
+* Get the speedo text for the first portion of the rendering.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetSpeedoText1() const
+{
+	return GetSpeedoText(0, SpeedoText1);
+}
+
+/**
+* Get the speedo text for the second portion of the rendering.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetSpeedoText2() const
+{
+	return GetSpeedoText(1, SpeedoText2);
+}
+
+/**
+* Get the speedo text for a portion of the rendering, from its cache.
+*
+* The cache is keyed on the speed as it's shown, and its number of digits, so the
+* text is only formatted again when the readout actually changes.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetSpeedoText(int32 index, TCachedText<FIntPoint>& cache) const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
+	FIntPoint key(0, 3);
+
+	if (vehicle != nullptr)
+	{
+		key.X = vehicle->GetDisplayedSpeed(index, key.Y);
 	}
+
+	return cache.Get(key, [vehicle, index] () { return FText::FromString((vehicle == nullptr) ? FString(TEXT("000")) : vehicle->GetFormattedSpeedKPH(index)); });
 }
 
 /**
@@ -312,6 +359,155 @@ FText UHUDWidgetComponent::GetKPHText() const
 	}
 }
 
+/**
+* Get the left text for the player position.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetPositionTextLeft() const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
+	int32 position = BlankNumber;
+
+	if (vehicle != nullptr &&
+		(vehicle->GetRaceState().LapNumber >= 0 || GameState->GamePlaySetup.DrivingMode == EDrivingMode::Elimination))
+	{
+		position = ((GameState->IsGameModeRanked() == true) ? vehicle->GetRaceState().RaceRank : vehicle->GetRaceState().RacePosition) + 1;
+	}
+
+	return GetNumberText(position, TEXT("%d"), PositionTextLeft);
+}
+
+/**
+* Get the right text for the player position.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetPositionTextRight() const
+{
+	return GetNumberText((GetTargetVehicle() == nullptr) ? BlankNumber : PlayGameMode->GetNumOpponentsLeft(), TEXT("/%d"), PositionTextRight);
+}
+
+/**
+* Get the left text for the player rank.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetRankTextLeft() const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
+
+	return GetNumberText((vehicle == nullptr) ? BlankNumber : vehicle->GetRaceState().RaceRank + 1, TEXT("%d"), RankTextLeft);
+}
+
+/**
+* Get the left text for the player lap.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetLapTextLeft() const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
+
+	return GetNumberText((vehicle == nullptr || vehicle->GetRaceState().LapNumber < 0) ? BlankNumber : vehicle->GetRaceState().LapNumber + 1, TEXT("%d"), LapTextLeft);
+}
+
+/**
+* Get the right text for the player lap.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetLapTextRight() const
+{
+	return GetNumberText((GetTargetVehicle() == nullptr) ? BlankNumber : (int32)GameState->GeneralOptions.NumberOfLaps, TEXT("/%d"), LapTextRight);
+}
+
+/**
+* Get the text for the player points.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetPointsText() const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
+
+	return GetNumberText((vehicle == nullptr) ? BlankNumber : vehicle->GetRaceState().NumInGamePoints, TEXT("%d"), PointsText);
+}
+
+/**
+* Get the text for the player kills.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetKillsText() const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
+
+	return GetNumberText((vehicle == nullptr) ? BlankNumber : (int32)vehicle->GetRaceState().NumKills, TEXT("%d"), KillsText);
+}
+
+/**
+* Get the text for the player deaths.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetDeathsText() const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
+
+	return GetNumberText((vehicle == nullptr) ? BlankNumber : (int32)vehicle->GetRaceState().NumDeaths, TEXT("/%d"), DeathsText);
+}
+
+/**
+* Get the text for the player damage.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetDamageText() const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
+	int32 damage = BlankNumber;
+
+	if (vehicle != nullptr)
+	{
+		const FPlayerRaceState& raceState = vehicle->GetRaceState();
+
+		damage = (int32)((float)(raceState.MaxHitPoints - raceState.HitPoints) / (float)raceState.MaxHitPoints * 100);
+	}
+
+	return GetNumberText(damage, TEXT("%d%%"), DamageText);
+}
+
+/**
+* Get the text for the elimination timer.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetEliminationTimerText() const
+{
+	int32 seconds = (PlayGameMode->GetEliminationTimer() >= 0.0f) ? FMath::CeilToInt(GRIP_ELIMINATION_SECONDS - PlayGameMode->GetEliminationTimer()) : BlankNumber;
+
+	return EliminationTimerText.Get(seconds, [seconds] () { return (seconds == BlankNumber) ? FText::FromString(TEXT("--")) : FText::FromString(FString::Printf(TEXT("%02d"), seconds)); });
+}
+
+/**
+* Get the race time of the vehicle.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetRaceTimeText() const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
+
+	if (vehicle == nullptr)
+	{
+		return FText::GetEmpty();
+	}
+
+	// The race time stands still whenever the race isn't running, and the text is only
+	// formatted again once it moves.
+
+	return RaceTimeText.Get(vehicle->GetRaceState().RaceTime, [vehicle] () { return FText::FromString(vehicle->GetFormattedRaceTime()); });
+}
+
+/**
+* Get the text for a number, or empty text for BlankNumber, from its cache.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::GetNumberText(int32 number, const TCHAR* format, TCachedText<int32>& cache)
+{
+	return cache.Get(number, [number, format] () { return (number == BlankNumber) ? FText::GetEmpty() : FText::FromString(FString::Printf(format, number)); });
+}
+
 /**
 * Get the title text for the event outro.
 ***********************************************************************************/
@@ -478,27 +674,21 @@ FLinearColor UHUDWidgetComponent::GetResetChargeColour() const
 
 bool UHUDWidgetComponent::IsWeaponEventOfInterest(int32 index) const
 {
-	TArray<FGameEvent>& events = PlayGameMode->GameEvents;
-
-	if (index < events.Num())
-	{
-		FGameEvent& event = events[index];
+	return (GetWeaponEvent(index) != nullptr);
+}
 
-		if (event.EventType == EGameEventType::Blocked ||
-			event.EventType == EGameEventType::Destroyed ||
-			event.EventType == EGameEventType::ChatMessage)
-		{
-			return true;
-		}
+/**
+* Get a weapon event for the HUD, 0 being the most recent, or nullptr if none.
+*
+* These are the events of interest involving the target vehicle, taken from its own
+* index in the game mode rather than by scanning all of the game events.
+***********************************************************************************/
 
-		if (event.EventType == EGameEventType::Impacted &&
-			(event.PickupUsed == EPickupType::HomingMissile))
-		{
-			return true;
-		}
-	}
+const FGameEvent* UHUDWidgetComponent::GetWeaponEvent(int32 index) const
+{
+	ABaseVehicle* vehicle = GetTargetVehicle();
 
-	return false;
+	return (vehicle == nullptr) ? nullptr : PlayGameMode->GetPlayerEventOfInterest(vehicle->VehicleIndex, index);
 }
 
 /**
@@ -507,19 +697,24 @@ bool UHUDWidgetComponent::IsWeaponEventOfInterest(int32 index) const
 
 FText UHUDWidgetComponent::GetWeaponEventLeftText(int32 index) const
 {
-	TArray<FGameEvent>& events = PlayGameMode->GameEvents;
+	const FGameEvent* event = GetWeaponEvent(index);
 
-	if (index < events.Num())
+	if (event != nullptr)
 	{
-		FGameEvent& event = events[index];
-
-		if (event.LaunchVehicleIndex >= 0)
+		if (event->LaunchVehicleIndex >= 0)
 		{
-			return FText::FromString(PlayGameMode->GetVehicleForVehicleIndex(event.LaunchVehicleIndex)->GetPlayerName(true, true));
+			auto build = [this, event] () { return FText::FromString(PlayGameMode->GetVehicleForVehicleIndex(event->LaunchVehicleIndex)->GetPlayerName(true, true)); };
+
+			if (index < NumCachedWeaponEvents)
+			{
+				return WeaponEventLeftTexts[index].Get(TPair<float, int32>(event->Time, event->LaunchVehicleIndex), build);
+			}
+
+			return build();
 		}
 	}
 
-	return FText::FromString("");
+	return FText::GetEmpty();
 }
 
 /**
@@ -528,26 +723,35 @@ FText UHUDWidgetComponent::GetWeaponEventLeftText(int32 index) const
 
 FText UHUDWidgetComponent::GetWeaponEventRightText(int32 index) const
 {
-	TArray<FGameEvent>& events = PlayGameMode->GameEvents;
+	const FGameEvent* event = GetWeaponEvent(index);
 
-	if (index < events.Num())
+	if (event != nullptr)
 	{
-		FGameEvent& event = events[index];
-
-		if (event.EventType == EGameEventType::ChatMessage)
+		if (event->EventType == EGameEventType::ChatMessage ||
+			event->TargetVehicleIndex >= 0)
 		{
-			return FText::FromString(" " + event.ExtraInformation);
-		}
-		else
-		{
-			if (event.TargetVehicleIndex >= 0)
+			auto build = [this, event] ()
 			{
-				return FText::FromString(PlayGameMode->GetVehicleForVehicleIndex(event.TargetVehicleIndex)->GetPlayerName(true, true));
+				if (event->EventType == EGameEventType::ChatMessage)
+				{
+					return FText::FromString(" " + PlayGameMode->GetGameEventString(event->ExtraInformation));
+				}
+				else
+				{
+					return FText::FromString(PlayGameMode->GetVehicleForVehicleIndex(event->TargetVehicleIndex)->GetPlayerName(true, true));
+				}
+			};
+
+			if (index < NumCachedWeaponEvents)
+			{
+				return WeaponEventRightTexts[index].Get(TPair<float, int32>(event->Time, event->TargetVehicleIndex), build);
 			}
+
+			return build();
 		}
 	}
 
-	return FText::FromString("");
+	return FText::GetEmpty();
 }
 
 /**
@@ -556,21 +760,19 @@ FText UHUDWidgetComponent::GetWeaponEventRightText(int32 index) const
 
 FSlateColor UHUDWidgetComponent::GetWeaponEventLeftColour(int32 index) const
 {
-	TArray<FGameEvent>& events = PlayGameMode->GameEvents;
+	const FGameEvent* event = GetWeaponEvent(index);
 
-	if (index < events.Num())
+	if (event != nullptr)
 	{
-		FGameEvent& event = events[index];
-
-		if (event.EventType == EGameEventType::ChatMessage)
+		if (event->EventType == EGameEventType::ChatMessage)
 		{
 			return FSlateColor(FLinearColor(1.0f, 0.5f, 0.0f, 1.0f));
 		}
-		else if (event.EventType == EGameEventType::Impacted)
+		else if (event->EventType == EGameEventType::Impacted)
 		{
 			if (OwningVehicle != nullptr)
 			{
-				if (event.LaunchVehicleIndex == OwningVehicle->VehicleIndex)
+				if (event->LaunchVehicleIndex == OwningVehicle->VehicleIndex)
 				{
 					return FSlateColor(FLinearColor(0.0f, 1.0f, 0.0f, 1.0f));
 				}
@@ -587,19 +789,18 @@ FSlateColor UHUDWidgetComponent::GetWeaponEventLeftColour(int32 index) const
 
 FSlateColor UHUDWidgetComponent::GetWeaponEventRightColour(int32 index) const
 {
-	TArray<FGameEvent>& events = PlayGameMode->GameEvents;
+	const FGameEvent* event = GetWeaponEvent(index);
 
-	if (index < events.Num())
+	if (event != nullptr)
 	{
-		FGameEvent& event = events[index];
 		ABaseVehicle* vehicle = GetTargetVehicle();
 
-		if (event.EventType == EGameEventType::ChatMessage)
+		if (event->EventType == EGameEventType::ChatMessage)
 		{
 			return FSlateColor(FLinearColor(1.0f, 1.0f, 1.0f, 1.0f));
 		}
-		else if ((event.EventType == EGameEventType::Impacted && vehicle != nullptr && event.TargetVehicleIndex == vehicle->VehicleIndex) ||
-			event.EventType == EGameEventType::Destroyed)
+		else if ((event->EventType == EGameEventType::Impacted && vehicle != nullptr && event->TargetVehicleIndex == vehicle->VehicleIndex) ||
+			event->EventType == EGameEventType::Destroyed)
 		{
 			return FSlateColor(FLinearColor(1.0f, 0.0f, 0.0f, 1.0f));
 		}
@@ -614,24 +815,22 @@ FSlateColor UHUDWidgetComponent::GetWeaponEventRightColour(int32 index) const
 
 int32 UHUDWidgetComponent::GetWeaponEventImageIndex(int32 index) const
 {
-	TArray<FGameEvent>& events = PlayGameMode->GameEvents;
+	const FGameEvent* event = GetWeaponEvent(index);
 
-	if (index < events.Num())
+	if (event != nullptr)
 	{
-		FGameEvent& event = events[index];
-
-		if (event.EventType == EGameEventType::Impacted)
+		if (event->EventType == EGameEventType::Impacted)
 		{
-			if (event.PickupUsed == EPickupType::HomingMissile)
+			if (event->PickupUsed == EPickupType::HomingMissile)
 			{
 				return 0;
 			}
 		}
-		else if (event.EventType == EGameEventType::Blocked)
+		else if (event->EventType == EGameEventType::Blocked)
 		{
 			return 3;
 		}
-		else if (event.EventType == EGameEventType::Destroyed)
+		else if (event->EventType == EGameEventType::Destroyed)
 		{
 			return 4;
 		}
@@ -645,6 +844,15 @@ int32 UHUDWidgetComponent::GetWeaponEventImageIndex(int32 index) const
 ***********************************************************************************/
 
 FText UHUDWidgetComponent::GetRacePositionScaleText(int32 distance) const
+{
+	return RacePositionScaleText.Get(distance, [distance] () { return FormatRacePositionScaleText(distance); });
+}
+
+/**
+* Format the text describing a race distance.
+***********************************************************************************/
+
+FText UHUDWidgetComponent::FormatRacePositionScaleText(int32 distance)
 {
 	FFormatNamedArguments arguments;
 
@@ -659,76 +867,79 @@ FText UHUDWidgetComponent::GetRacePositionScaleText(int32 distance) const
 
 int32 UHUDWidgetComponent::GetRacePositionScale() const
 {
-	if (GetTargetVehicle() != nullptr)
-	{
-		float maxDistance = 0.0f;
-		ABaseVehicle* yourVehicle = GetTargetVehicle();
-
-		if (yourVehicle != nullptr)
-		{
-			int32 you = GetTargetVehicle()->VehicleIndex;
-			TArray<ABaseVehicle*>& vehicles = PlayGameMode->GetVehicles();
+	ABaseVehicle* yourVehicle = GetTargetVehicle();
 
-			for (ABaseVehicle* vehicle : vehicles)
-			{
-				if (vehicle->VehicleIndex != you &&
-					vehicle->IsVehicleDestroyed() == false)
-				{
-					maxDistance = FMath::Max(maxDistance, FMath::Abs(vehicle->GetRaceState().RaceDistance - yourVehicle->GetRaceState().RaceDistance));
-				}
-			}
-
-			float packLength = FMath::Clamp(maxDistance, 500.0f * 100.0f, 2000.0f * 100.0f);
-
-			return (int32)(packLength / 100.0f);
-		}
+	if (yourVehicle != nullptr &&
+		yourVehicle->VehicleIndex < GRIP_MAX_PLAYERS)
+	{
+		return PlayGameMode->GetHUDRaceSnapshot().PackScales[yourVehicle->VehicleIndex];
 	}
 
 	return 0;
 }
 
 /**
-* Get all of the race positions for all of the players.
+* Bring the race positions for all of the players up to date for a layout.
+*
+* These are built from the race snapshot in the game mode and only rebuilt when
+* that or the requested layout changes, reusing the same array each time. Blueprint
+* always receives a copy of an array returned from a function, so it should walk
+* them with GetNumRacePositions and GetRacePosition rather than GetRacePositions,
+* which only saves the rebuild and not the copy.
 ***********************************************************************************/
 
-TArray<FHUDRacePosition> UHUDWidgetComponent::GetRacePositions(float centre, float length) const
+const TArray<FHUDRacePosition>& UHUDWidgetComponent::UpdateRacePositions(float centre, float length) const
 {
-	TArray<FHUDRacePosition> positions;
-
 	ABaseVehicle* thisVehicle = GetTargetVehicle();
 
-	if (thisVehicle != nullptr)
+	if (thisVehicle == nullptr ||
+		thisVehicle->VehicleIndex >= GRIP_MAX_PLAYERS)
+	{
+		RacePositions.Reset();
+		RacePositionsFrameNumber = -1;
+
+		return RacePositions;
+	}
+
+	const FHUDRaceSnapshot& snapshot = PlayGameMode->GetHUDRaceSnapshot();
+	int32 you = thisVehicle->VehicleIndex;
+
+	if (RacePositionsFrameNumber != snapshot.FrameNumber ||
+		RacePositionsVehicleIndex != you ||
+		RacePositionsCentre != centre ||
+		RacePositionsLength != length)
 	{
-		float packLength = (float)GetRacePositionScale();
-		TArray<ABaseVehicle*>& vehicles = PlayGameMode->GetVehicles();
+		RacePositionsFrameNumber = snapshot.FrameNumber;
+		RacePositionsVehicleIndex = you;
+		RacePositionsCentre = centre;
+		RacePositionsLength = length;
 
-		positions.Reserve(vehicles.Num() - 1);
+		RacePositions.Reset();
 
-		for (ABaseVehicle* vehicle : vehicles)
+		float packLength = (float)snapshot.PackScales[you];
+
+		for (int32 i = 0; i < GRIP_MAX_PLAYERS; i++)
 		{
-			if (vehicle->IsVehicleDestroyed() == false &&
-				vehicle != thisVehicle)
+			if (i != you &&
+				snapshot.Present[i] == true &&
+				snapshot.Destroyed[i] == false)
 			{
-				FHUDRacePosition position;
-
-				float relativeWorldDistance = (vehicle->GetRaceState().RaceDistance - thisVehicle->GetRaceState().RaceDistance) / 100.0f;
+				FHUDRacePosition& position = RacePositions[RacePositions.AddDefaulted()];
+				float relativeWorldDistance = (snapshot.RaceDistances[i] - snapshot.RaceDistances[you]) / 100.0f;
 
-				position.RelativeWidgetDistance = FMath::Clamp(relativeWorldDistance / packLength, -1.0f, 1.0f);
+				position.RelativeWidgetDistance = (packLength > 0.0f) ? FMath::Clamp(relativeWorldDistance / packLength, -1.0f, 1.0f) : 0.0f;
 				position.RelativeWidgetDistance = (position.RelativeWidgetDistance * length * -0.5f) + centre;
 				position.IsRival = false;
 				position.IsUsingDisruptor = false;
-				position.Colour = PlayGameMode->GetTeamColour(-1);
 
 				float teleportRatio = 0.0f;
 
-				position.Colour = FMath::Lerp(FLinearColor(1.0f, 0.33f, 0.0f, 1.0f), position.Colour, teleportRatio * teleportRatio * teleportRatio);
-
-				positions.Emplace(position);
+				position.Colour = FMath::Lerp(FLinearColor(1.0f, 0.33f, 0.0f, 1.0f), snapshot.Colours[i], teleportRatio * teleportRatio * teleportRatio);
 			}
 		}
 	}
 
-	return positions;
+	return RacePositions;
 }
 
 /**
@@ -751,7 +962,15 @@ void UHUDWidgetComponent::AddIgnitionWidgets(UPanelWidget* mainPanel)
 
 			if (userWidget != nullptr)
 			{
-				IgnitionWidgets.Emplace(FHUDPanelIgnition(userWidget, FMath::FRandRange(3.0f, 4.0f)));
+				FHUDPanelIgnition& ignition = IgnitionWidgets[IgnitionWidgets.Emplace(FHUDPanelIgnition(userWidget, FMath::FRandRange(3.0f, 4.0f)))];
+
+				// Resolve the widgets to be faded up front, so the per-frame refresh
+				// doesn't need to walk and cast its way through the hierarchy.
+
+				if (UCanvasPanel* canvas = Cast<UCanvasPanel>(userWidget->GetRootWidget()))
+				{
+					ResolveIgnitionWidgets(ignition, canvas);
+				}
 			}
 		}
 	}
@@ -765,21 +984,40 @@ void UHUDWidgetComponent::RefreshIgnitionWidgets()
 {
 	for (FHUDPanelIgnition& widget : IgnitionWidgets)
 	{
-		if (UCanvasPanel* panel = Cast<UCanvasPanel>(widget.Widget->GetRootWidget()))
-		{
-			RefreshIgnitionWidgets(widget, panel);
-		}
+		RefreshIgnitionWidgets(widget);
 	}
 }
 
 /**
-* Refresh all of the widgets that can be ignited for a particular panel.
+* Refresh the opacity of all of the widgets resolved for a particular ignition.
 ***********************************************************************************/
 
-void UHUDWidgetComponent::RefreshIgnitionWidgets(FHUDPanelIgnition& ignition, UPanelWidget* mainPanel)
+void UHUDWidgetComponent::RefreshIgnitionWidgets(FHUDPanelIgnition& ignition)
 {
 	float opacity = GetPanelOpacity(ignition);
 
+	for (UBorder* border : ignition.Borders)
+	{
+		FLinearColor color = border->ContentColorAndOpacity;
+
+		color.A = opacity;
+
+		border->SetBrushColor(color);
+		border->SetContentColorAndOpacity(color);
+	}
+
+	for (UTextBlock* textBlock : ignition.TextBlocks)
+	{
+		textBlock->SetOpacity(opacity);
+	}
+}
+
+/**
+* Resolve all of the widgets within a panel whose opacity is driven by an ignition.
+***********************************************************************************/
+
+void UHUDWidgetComponent::ResolveIgnitionWidgets(FHUDPanelIgnition& ignition, UPanelWidget* mainPanel)
+{
 	for (int32 i = 0; i < mainPanel->GetChildrenCount(); i++)
 	{
 		UWidget* child = mainPanel->GetChildAt(i);
@@ -787,19 +1025,14 @@ void UHUDWidgetComponent::RefreshIgnitionWidgets(FHUDPanelIgnition& ignition, UP
 
 		if (border != nullptr)
 		{
-			FLinearColor color = border->ContentColorAndOpacity;
-
-			color.A = opacity;
-
-			border->SetBrushColor(color);
-			border->SetContentColorAndOpacity(color);
+			ignition.Borders.Emplace(border);
 		}
 
 		UPanelWidget* panel = Cast<UPanelWidget>(child);
 
 		if (panel != nullptr)
 		{
-			RefreshIgnitionWidgets(ignition, panel);
+			ResolveIgnitionWidgets(ignition, panel);
 		}
 		else
 		{
@@ -807,7 +1040,7 @@ void UHUDWidgetComponent::RefreshIgnitionWidgets(FHUDPanelIgnition& ignition, UP
 
 			if (textBlock != nullptr)
 			{
-				textBlock->SetOpacity(opacity);
+				ignition.TextBlocks.Emplace(textBlock);
 			}
 		}
 	}
@@ -967,9 +1200,32 @@ void UHUDWidget::SetupForPlayer(ULocalPlayer* localPlayer)
 
 	SetOwningLocalPlayer(localPlayer);
 
+	if (PlayGameMode != nullptr &&
+		LapCompletedHandle.IsValid() == false)
+	{
+		LapCompletedHandle = PlayGameMode->OnRaceEvent(ERaceEventType::LapCompleted).AddUObject(this, &UHUDWidget::OnLapCompleted);
+	}
+
 	SetupForGameMode(localPlayer);
 }
 
+/**
+* Destruct the HUD widget.
+***********************************************************************************/
+
+void UHUDWidget::NativeDestruct()
+{
+	if (PlayGameMode != nullptr &&
+		LapCompletedHandle.IsValid() == true)
+	{
+		PlayGameMode->OnRaceEvent(ERaceEventType::LapCompleted).Remove(LapCompletedHandle);
+	}
+
+	LapCompletedHandle.Reset();
+
+	Super::NativeDestruct();
+}
+
 /**
 * Setup the components of the HUD widget.
 ***********************************************************************************/
@@ -1026,6 +1282,40 @@ void UHUDWidget::SetupComponents(UCanvasPanel* mainPanel) const
 
 		mainPanel->RemoveChildAt(index - numRemoved++);
 	}
+
+	InvalidateComponents();
+}
+
+/**
+* Get the components of the HUD widget that use ignition, resolving them if the
+* hierarchy has changed.
+***********************************************************************************/
+
+const TArray<UHUDWidgetComponent*>& UHUDWidget::GetIgnitionComponents() const
+{
+	UPanelWidget* panel = Cast<UCanvasPanel>(GetRootWidget());
+
+	if (panel != ComponentsPanel ||
+		(panel != nullptr && panel->GetChildrenCount() != ComponentsPanelNumChildren))
+	{
+		IgnitionComponents.Reset();
+
+		ComponentsPanel = panel;
+		ComponentsPanelNumChildren = (panel != nullptr) ? panel->GetChildrenCount() : 0;
+
+		for (int32 i = 0; i < ComponentsPanelNumChildren; i++)
+		{
+			UHUDWidgetComponent* hudComponent = Cast<UHUDWidgetComponent>(panel->GetChildAt(i));
+
+			if (hudComponent != nullptr &&
+				hudComponent->UseIgnition == true)
+			{
+				IgnitionComponents.Emplace(hudComponent);
+			}
+		}
+	}
+
+	return IgnitionComponents;
 }
 
 /**
@@ -1037,20 +1327,9 @@ void UHUDWidget::Update(float deltaSeconds)
 	if (PlayGameMode->GetClock() > 0.0f &&
 		PlayGameMode->GetClock() - PlayGameMode->LastOptionsResetTime < 10.0f)
 	{
-		UWidget* root = GetRootWidget();
-
-		if (UCanvasPanel* panel = Cast<UCanvasPanel>(root))
+		for (UHUDWidgetComponent* hudComponent : GetIgnitionComponents())
 		{
-			for (int32 i = 0; i < panel->GetChildrenCount(); i++)
-			{
-				UHUDWidgetComponent* hudComponent = Cast<UHUDWidgetComponent>(panel->GetChildAt(i));
-
-				if (hudComponent != nullptr &&
-					hudComponent->UseIgnition == true)
-				{
-					hudComponent->UpdateIgnition(deltaSeconds);
-				}
-			}
+			hudComponent->UpdateIgnition(deltaSeconds);
 		}
 	}
 }
@@ -1067,42 +1346,26 @@ void UHUDWidget::Ignite()
 
 		PlayGameMode->LastOptionsResetTime = PlayGameMode->GetClock();
 
-		UWidget* root = GetRootWidget();
-
-		if (UCanvasPanel* panel = Cast<UCanvasPanel>(root))
+		for (UHUDWidgetComponent* hudComponent : GetIgnitionComponents())
 		{
-			for (int32 i = 0; i < panel->GetChildrenCount(); i++)
-			{
-				UHUDWidgetComponent* hudComponent = Cast<UHUDWidgetComponent>(panel->GetChildAt(i));
-
-				if (hudComponent != nullptr &&
-					hudComponent->UseIgnition == true)
-				{
-					hudComponent->Ignite();
-				}
-			}
+			hudComponent->Ignite();
 		}
 	}
 }
 
 /**
-* Tick the HUD widget.
+* Handle a lap being completed by any vehicle.
 ***********************************************************************************/
 
-void UHUDWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UHUDWidget::OnLapCompleted(const FRaceEvent& raceEvent)
 {
-	Super::NativeTick(MyGeometry, InDeltaTime);
-
 	ABaseVehicle* vehicle = GetOwningVehicle();
 
 	if (vehicle != nullptr &&
-		vehicle->GetRaceState().LapNumber != LastLapCompleted &&
-		vehicle->GetRaceState().LapNumber > 0)
+		vehicle->VehicleIndex == raceEvent.VehicleIndex)
 	{
 		LapCompleted(vehicle->GetRaceState().PlayerCompletionState < EPlayerCompletionState::Complete &&
 			GameState->IsGameModeLapBased() == true &&
-			vehicle->GetRaceState().LapNumber == GameState->GeneralOptions.NumberOfLaps - 1);
-
-		LastLapCompleted = vehicle->GetRaceState().LapNumber;
+			raceEvent.Value == GameState->GeneralOptions.NumberOfLaps - 1);
 	}
 }
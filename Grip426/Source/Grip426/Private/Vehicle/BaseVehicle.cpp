@@ -61,6 +61,7 @@ USoundCue* FVehicleElimination::AlertSound = nullptr;
 
 float ABaseVehicle::PickupHookTime = 0.5f;
 bool ABaseVehicle::ProbabilitiesInitialized = false;
+const float ABaseVehicle::MaxParticleSystemDistance = 500.0f * 100.0f;
 
 #pragma region Vehicle
 
@@ -445,7 +446,7 @@ void ABaseVehicle::UpdatePhysics(float deltaSeconds, const FTransform& transform
 				ShieldChargedImpactSound = shield->ChargedImpact;
 			}
 
-			UGameplayStatics::SpawnSoundAttached(ShieldChargedImpactSound, VehicleMesh, NAME_None, FVector::ZeroVector, EAttachLocation::Type::KeepRelativeOffset);
+			PlayAttachedSound(ShieldChargedImpactSound);
 		}
 	}
 
@@ -578,7 +579,34 @@ void ABaseVehicle::ClientPlaySound(USoundBase* Sound, float VolumeMultiplier, fl
 	if (IsHumanPlayer() == true &&
 		HasAIDriver() == false)
 	{
-		UGameplayStatics::PlaySound2D(this, Sound, VolumeMultiplier, PitchMultiplier);
+		if (PlayGameMode != nullptr)
+		{
+			PlayGameMode->GetVehicleAudioManager().PlaySound2D(Sound, this, VolumeMultiplier, PitchMultiplier);
+		}
+		else
+		{
+			UGameplayStatics::PlaySound2D(this, Sound, VolumeMultiplier, PitchMultiplier);
+		}
+	}
+}
+
+/**
+* Play a one-shot sound attached to the vehicle, within the voice budget for all of
+* the vehicles.
+*
+* All of the one-shot sounds on vehicles, whether played from code or Blueprint,
+* should come through here, so that a pile-up can't flood the mixer.
+***********************************************************************************/
+
+UAudioComponent* ABaseVehicle::PlayAttachedSound(USoundBase* sound, float volume, float pitch)
+{
+	if (PlayGameMode != nullptr)
+	{
+		return PlayGameMode->GetVehicleAudioManager().PlaySoundAttached(sound, this, VehicleMesh, volume, pitch);
+	}
+	else
+	{
+		return UGameplayStatics::SpawnSoundAttached(sound, VehicleMesh, NAME_None, FVector::ZeroVector, EAttachLocation::Type::KeepRelativeOffset, false, volume, pitch);
 	}
 }
 
@@ -595,16 +623,93 @@ void ABaseVehicle::PlayDeniedSound()
 	}
 }
 
+/**
+* Virtualize the engine audio, stopping it while the vehicle can't be heard and
+* restarting it when it can.
+*
+* Only the components that were playing when virtualized are restarted, so that we
+* don't start sounds that the engine audio update has deliberately stopped.
+***********************************************************************************/
+
+void ABaseVehicle::SetEngineAudioVirtualized(bool virtualized)
+{
+	if (EngineAudioVirtualized == virtualized)
+	{
+		return;
+	}
+
+	EngineAudioVirtualized = virtualized;
+
+	int32 bit = 0;
+
+	for (TArray<UAudioComponent*>* components : { &JetEngineAudio, &PistonEngineAudio })
+	{
+		for (UAudioComponent* component : *components)
+		{
+			if (component != nullptr &&
+				bit < 32)
+			{
+				if (virtualized == true)
+				{
+					if (component->IsPlaying() == true)
+					{
+						VirtualizedEngineAudio |= 1 << bit;
+
+						component->Stop();
+					}
+				}
+				else if ((VirtualizedEngineAudio & (1 << bit)) != 0)
+				{
+					component->Play();
+				}
+			}
+
+			bit++;
+		}
+	}
+
+	if (virtualized == false)
+	{
+		VirtualizedEngineAudio = 0;
+	}
+}
+
 /**
 * Get the speed of the vehicle, in kilometers / miles per hour.
 ***********************************************************************************/
 
 FString ABaseVehicle::GetFormattedSpeedKPH(int32 index) const
 {
+	int32 numDigits = 3;
+	int32 speed = GetDisplayedSpeed(index, numDigits);
+
+	switch (numDigits)
+	{
+	case 1:
+		return FString::Printf(TEXT("%01d"), speed);
+	case 2:
+		return FString::Printf(TEXT("%02d"), speed);
+	default:
+		return FString::Printf(TEXT("%03d"), speed);
+	}
+}
+
+/**
+* Get the speed of the vehicle as shown on the speedometer, and the number of digits
+* to show it with.
+*
+* Mach speeds are shown in two parts, the whole number for index 0 and the hundredths
+* for index 1.
+***********************************************************************************/
+
+int32 ABaseVehicle::GetDisplayedSpeed(int32 index, int32& numDigits) const
+{
+	numDigits = 3;
+
 	if (GameState->TransientGameState.ShowFPS == true &&
 		GameState->GeneralOptions.SpeedUnit != ESpeedDisplayUnit::MACH)
 	{
-		return FString::Printf(TEXT("%03d"), FMath::RoundToInt(1.0f / PlayGameMode->FrameTimes.GetScaledMeanValue()));
+		return FMath::RoundToInt(1.0f / PlayGameMode->FrameTimes.GetScaledMeanValue());
 	}
 	else
 	{
@@ -613,17 +718,21 @@ FString ABaseVehicle::GetFormattedSpeedKPH(int32 index) const
 		switch (GameState->GeneralOptions.SpeedUnit)
 		{
 		case ESpeedDisplayUnit::MPH:
-			return FString::Printf(TEXT("%03d"), FMath::FloorToInt(speed * 0.621371f));
+			return FMath::FloorToInt(speed * 0.621371f);
 		case ESpeedDisplayUnit::KPH:
-			return FString::Printf(TEXT("%03d"), FMath::FloorToInt(speed));
+			return FMath::FloorToInt(speed);
 		default:
 			if (index == 0)
 			{
-				return FString::Printf(TEXT("%01d"), FMath::FloorToInt(speed * 0.000809848f));
+				numDigits = 1;
+
+				return FMath::FloorToInt(speed * 0.000809848f);
 			}
 			else
 			{
-				return FString::Printf(TEXT("%02d"), FMath::FloorToInt(FMath::Frac(speed * 0.000809848f) * 100.0f));
+				numDigits = 2;
+
+				return FMath::FloorToInt(FMath::Frac(speed * 0.000809848f) * 100.0f);
 			}
 		}
 	}
@@ -680,8 +789,9 @@ void ABaseVehicle::ShowStatusMessage(const FStatusMessage& message, bool queue,
 				FGameEvent event;
 
 				event.LaunchVehicleIndex = -1;
+				event.TargetVehicleIndex = VehicleIndex;
 				event.EventType = EGameEventType::ChatMessage;
-				event.ExtraInformation = message.Message.ToString();
+				event.ExtraInformation = PlayGameMode->InternGameEventString(message.Message.ToString());
 
 				PlayGameMode->AddGameEvent(event);
 			}
@@ -998,22 +1108,42 @@ const FString& ABaseVehicle::GetPlayerName(bool shortened, bool full)
 
 /**
 * Spawn an appropriately scaled particle system on the vehicle.
+*
+* Effects that would be auto-destroyed are short-lived, so they're taken from a pool
+* of components for their template instead of being created each time. Cosmetic
+* effects that are spawned with canReject may also be rejected altogether, and
+* nullptr returned, if too many have been spawned on this vehicle this frame or it's
+* too far from any of the cameras to see them. Effects that must play, like those
+* for destruction, resets and launches, should never be spawned with canReject.
 ***********************************************************************************/
 
-UParticleSystemComponent* ABaseVehicle::SpawnParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale, bool autoDestroy)
+UParticleSystemComponent* ABaseVehicle::SpawnParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale, bool autoDestroy, bool canReject)
 {
 	UParticleSystemComponent* component = nullptr;
 
 	if (emitterTemplate != nullptr)
 	{
-		component = NewObject<UParticleSystemComponent>(RootComponent->GetOwner());
+		if (autoDestroy == true)
+		{
+			if (canReject == true &&
+				ShouldSpawnPooledParticleSystem() == false)
+			{
+				return nullptr;
+			}
 
-		component->bAutoDestroy = autoDestroy;
-		component->bAllowAnyoneToDestroyMe = true;
-		component->SecondsBeforeInactive = 0.0f;
-		component->bAutoActivate = false;
-		component->SetTemplate(emitterTemplate);
-		component->bOverrideLODMethod = false;
+			component = GetPooledParticleSystem(emitterTemplate);
+		}
+		else
+		{
+			component = NewObject<UParticleSystemComponent>(RootComponent->GetOwner());
+
+			component->bAutoDestroy = false;
+			component->bAllowAnyoneToDestroyMe = true;
+			component->SecondsBeforeInactive = 0.0f;
+			component->bAutoActivate = false;
+			component->SetTemplate(emitterTemplate);
+			component->bOverrideLODMethod = false;
+		}
 
 		GRIP_ATTACH(component, RootComponent, attachPointName);
 
@@ -1032,13 +1162,131 @@ UParticleSystemComponent* ABaseVehicle::SpawnParticleSystem(UParticleSystem* emi
 		}
 
 		component->SetRelativeScale3D(AttachedEffectsScale * scale);
-		component->RegisterComponent();
+
+		if (component->IsRegistered() == false)
+		{
+			component->RegisterComponent();
+		}
+
 		component->ActivateSystem(true);
 	}
 
 	return component;
 }
 
+/**
+* Get a particle system component from the pool for a template.
+*
+* A component is free for reuse once its system has completed. If none are free and
+* the pool is full then the one that was started longest ago is restarted.
+***********************************************************************************/
+
+UParticleSystemComponent* ABaseVehicle::GetPooledParticleSystem(UParticleSystem* emitterTemplate)
+{
+	FParticleSystemPool& pool = ParticleSystemPools.FindOrAdd(emitterTemplate);
+	float time = World->GetTimeSeconds();
+
+	for (int32 i = 0; i < pool.Components.Num(); i++)
+	{
+		if (pool.Components[i]->IsActive() == false)
+		{
+			pool.StartTimes[i] = time;
+
+			return pool.Components[i];
+		}
+	}
+
+	if (pool.Components.Num() >= MaxPooledParticleSystems)
+	{
+		int32 oldest = 0;
+
+		for (int32 i = 1; i < pool.StartTimes.Num(); i++)
+		{
+			if (pool.StartTimes[oldest] > pool.StartTimes[i])
+			{
+				oldest = i;
+			}
+		}
+
+		UParticleSystemComponent* component = pool.Components[oldest];
+
+		pool.StartTimes[oldest] = time;
+
+		component->DeactivateImmediate();
+
+		return component;
+	}
+
+	UParticleSystemComponent* component = NewObject<UParticleSystemComponent>(RootComponent->GetOwner());
+
+	component->bAutoDestroy = false;
+	component->bAllowAnyoneToDestroyMe = false;
+	component->SecondsBeforeInactive = 0.0f;
+	component->bAutoActivate = false;
+	component->SetTemplate(emitterTemplate);
+	component->bOverrideLODMethod = false;
+
+	pool.Components.Emplace(component);
+	pool.StartTimes.Emplace(time);
+
+	return component;
+}
+
+/**
+* Should a rejectable particle system be spawned on this vehicle this frame?
+*
+* The cap is per vehicle so that a pile-up around one vehicle can't starve the
+* effects of all of the others.
+***********************************************************************************/
+
+bool ABaseVehicle::ShouldSpawnPooledParticleSystem() const
+{
+	if (ParticleSystemSpawnFrame != GFrameCounter)
+	{
+		ParticleSystemSpawnFrame = GFrameCounter;
+		NumParticleSystemSpawns = 0;
+	}
+
+	if (NumParticleSystemSpawns >= MaxParticleSystemSpawnsPerFrame)
+	{
+		return false;
+	}
+
+	// Reject the effect if there are local cameras but none of them are near enough
+	// to the vehicle to make it out.
+
+	bool tooFar = false;
+	FVector location = GetActorLocation();
+	float maxDistanceSquared = FMath::Square(MaxParticleSystemDistance);
+
+	for (FConstPlayerControllerIterator iterator = World->GetPlayerControllerIterator(); iterator; ++iterator)
+	{
+		APlayerController* controller = iterator->Get();
+
+		if (controller != nullptr &&
+			controller->IsLocalController() == true &&
+			controller->PlayerCameraManager != nullptr)
+		{
+			if (FVector::DistSquared(controller->PlayerCameraManager->GetCameraLocation(), location) < maxDistanceSquared)
+			{
+				tooFar = false;
+				break;
+			}
+
+			tooFar = true;
+		}
+	}
+
+	if (tooFar == true)
+	{
+		return false;
+	}
+
+	NumParticleSystemSpawns++;
+
+	return true;
+}
+
 /**
 * Shakes the user GamePad, according to strength and duration.
 ***********************************************************************************/
@@ -1108,6 +1356,9 @@ bool ABaseVehicle::ShakeCamera(float strength)
 
 void ABaseVehicle::BeginTeleport()
 {
+	// Don't sweep the teleport itself against the checkpoints.
+
+	RaceState.CheckpointSweepValid = false;
 }
 
 /**
@@ -38,6 +38,17 @@ FVehicleAI::FVehicleAI()
 	}
 }
 
+/**
+* Set the optimum and minimum speeds from a pursuit spline's speed profile.
+***********************************************************************************/
+
+void FVehicleAI::SetSpeedsFromSpline(const UPursuitSplineComponent* spline, float distance)
+{
+	OptimumSpeed = spline->GetOptimumSpeedAtDistance(distance);
+	TrackOptimumSpeed = OptimumSpeed;
+	MinimumSpeed = spline->GetMinimumSpeedAtDistance(distance);
+}
+
 /**
 * Lock the steering to spline direction?
 ***********************************************************************************/
@@ -54,3 +65,106 @@ bool ABaseVehicle::AIVehicleGoodForLaunch(float probability, float minimumSpeedK
 {
 	return false;
 }
+
+/**
+* Make the AI decisions for this frame from a snapshot of the world, safe to call on
+* any thread.
+*
+* Nothing here may touch any live actor, this vehicle's mutable state included, as
+* the decisions for all of the bots are made in parallel. Everything that's read
+* about the world, this vehicle's own control and AI state included, comes from the
+* snapshot, and everything that's decided goes into the decision to be applied
+* afterwards.
+***********************************************************************************/
+
+void ABaseVehicle::DecideAI(const FAIWorldSnapshot& snapshot, FVehicleAIDecision& decision) const
+{
+	decision = FVehicleAIDecision();
+
+	if (snapshot.Vehicles.IsValidIndex(VehicleIndex) == false)
+	{
+		return;
+	}
+
+	const FVehicleAISnapshot& us = snapshot.Vehicles[VehicleIndex];
+
+	if (us.Valid == false ||
+		us.Destroyed == true)
+	{
+		return;
+	}
+
+	decision.Valid = true;
+	decision.SteeringInput = us.SteeringInput;
+	decision.ThrottleInput = us.ThrottleInput;
+	decision.BrakeInput = us.BrakeInput;
+	decision.DrivingMode = us.DrivingMode;
+	decision.HeadingTo = us.HeadingTo;
+
+	// Look for anything in a cone ahead of us that would make using a turbo a bad idea.
+
+	const float turboRange = 50.0f * 100.0f;
+	const float turboCone = 0.9f;
+
+	for (int32 i = 0; i < snapshot.Vehicles.Num(); i++)
+	{
+		const FVehicleAISnapshot& other = snapshot.Vehicles[i];
+
+		if (i != VehicleIndex &&
+			other.Valid == true &&
+			other.Destroyed == false)
+		{
+			FVector difference = other.Location - us.Location;
+			float distance = difference.Size();
+
+			if (distance < turboRange &&
+				FVector::DotProduct(difference, us.Direction) > distance * turboCone)
+			{
+				decision.TurboObstacles = true;
+				break;
+			}
+		}
+	}
+
+	for (const FAvoidableAISnapshot& avoidable : snapshot.Avoidables)
+	{
+		FVector difference = avoidable.Location - us.Location;
+		float distance = FMath::Max(difference.Size() - avoidable.Radius, 0.0f);
+
+		if (distance < turboRange &&
+			FVector::DotProduct(difference, us.Direction) > distance * turboCone)
+		{
+			decision.NonVehicleTurboObstacles = true;
+			decision.TurboObstacles = true;
+			break;
+		}
+	}
+}
+
+/**
+* Apply the AI decisions made for this frame, on the game thread.
+***********************************************************************************/
+
+void ABaseVehicle::ApplyAIDecision(const FVehicleAIDecision& decision)
+{
+	if (decision.Valid == false)
+	{
+		return;
+	}
+
+	Control.SteeringInputAnalog = decision.SteeringInput;
+	Control.ThrottleInput = decision.ThrottleInput;
+	Control.BrakeInput = decision.BrakeInput;
+
+	if (AI.DrivingMode != decision.DrivingMode)
+	{
+		AI.DrivingModeTimes[(int32)AI.DrivingMode] = VehicleClock;
+		AI.DrivingMode = decision.DrivingMode;
+		AI.DrivingModeTime = 0.0f;
+		AI.DrivingModeDistance = 0.0f;
+	}
+
+	AI.HeadingTo = decision.HeadingTo;
+	AI.TurboObstacles = decision.TurboObstacles;
+	AI.NonVehicleTurboObstacles = decision.NonVehicleTurboObstacles;
+}
@@ -12,3 +12,272 @@
 ***********************************************************************************/
 
 #include "vehicle/vehicleaudio.h"
+#include "vehicle/basevehicle.h"
+#include "components/audiocomponent.h"
+
+const float FVehicleAudioManager::MaxAudibleDistance = 250.0f * 100.0f;
+
+/**
+* Update the audibility of the vehicles and virtualize the engine audio of those
+* that can't be heard.
+*
+* Human players are always fully audible, as you always need to hear your own
+* vehicle. Everyone else is ranked by their distance to the nearest listener, and
+* only the most audible few keep their engines running.
+***********************************************************************************/
+
+void FVehicleAudioManager::Tick(UWorld* world, const TArray<ABaseVehicle*>& vehicles)
+{
+	TArray<FVector, TInlineAllocator<GRIP_MAX_LOCAL_PLAYERS>> listeners;
+
+	GetListenerLocations(world, listeners);
+
+	TArray<ABaseVehicle*, TInlineAllocator<GRIP_MAX_PLAYERS>> ranked;
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		int32 vehicleIndex = vehicle->VehicleIndex;
+
+		if (vehicleIndex < 0 ||
+			vehicleIndex >= GRIP_MAX_PLAYERS)
+		{
+			continue;
+		}
+
+		Audibility[vehicleIndex] = ComputeAudibility(vehicle, listeners);
+		AudibilityFrames[vehicleIndex] = GFrameCounter;
+
+		ranked.Emplace(vehicle);
+	}
+
+	ranked.Sort([this] (const ABaseVehicle& object1, const ABaseVehicle& object2)
+		{
+			return Audibility[object1.VehicleIndex] > Audibility[object2.VehicleIndex];
+		});
+
+	for (int32 i = 0; i < ranked.Num(); i++)
+	{
+		ABaseVehicle* vehicle = ranked[i];
+		bool audible = (Audibility[vehicle->VehicleIndex] >= 1.0f || (i < MaxEngineVehicles && Audibility[vehicle->VehicleIndex] > 0.0f));
+
+		vehicle->SetEngineAudioVirtualized(audible == false);
+	}
+}
+
+/**
+* Get the locations of all of the local listeners.
+***********************************************************************************/
+
+void FVehicleAudioManager::GetListenerLocations(UWorld* world, TArray<FVector, TInlineAllocator<GRIP_MAX_LOCAL_PLAYERS>>& listeners)
+{
+	for (FConstPlayerControllerIterator iterator = world->GetPlayerControllerIterator(); iterator; ++iterator)
+	{
+		APlayerController* controller = iterator->Get();
+
+		if (controller != nullptr &&
+			controller->IsLocalController() == true)
+		{
+			FVector location;
+			FVector frontDirection;
+			FVector rightDirection;
+
+			controller->GetAudioListenerPosition(location, frontDirection, rightDirection);
+
+			listeners.Emplace(location);
+		}
+	}
+}
+
+/**
+* Compute the audibility of a vehicle, between 0 and 1, from the locations of the
+* listeners.
+***********************************************************************************/
+
+float FVehicleAudioManager::ComputeAudibility(const ABaseVehicle* vehicle, const TArray<FVector, TInlineAllocator<GRIP_MAX_LOCAL_PLAYERS>>& listeners)
+{
+	if (vehicle->IsHumanPlayer() == true)
+	{
+		return 1.0f;
+	}
+
+	float audibility = 0.0f;
+	FVector location = vehicle->GetActorLocation();
+
+	for (const FVector& listener : listeners)
+	{
+		audibility = FMath::Max(audibility, 1.0f - (FVector::Dist(listener, location) / MaxAudibleDistance));
+	}
+
+	return audibility;
+}
+
+/**
+* Get the audibility of a vehicle, computing it if it wasn't updated last frame.
+*
+* Sounds can be played before the first tick of the manager, or while it isn't
+* ticking, and we don't want them dropped for want of an audibility.
+***********************************************************************************/
+
+float FVehicleAudioManager::GetCurrentAudibility(const ABaseVehicle* vehicle)
+{
+	int32 vehicleIndex = vehicle->VehicleIndex;
+
+	if (vehicleIndex < 0 ||
+		vehicleIndex >= GRIP_MAX_PLAYERS)
+	{
+		return 0.0f;
+	}
+
+	if (AudibilityFrames[vehicleIndex] == 0 ||
+		AudibilityFrames[vehicleIndex] + 1 < GFrameCounter)
+	{
+		TArray<FVector, TInlineAllocator<GRIP_MAX_LOCAL_PLAYERS>> listeners;
+
+		GetListenerLocations(vehicle->GetWorld(), listeners);
+
+		Audibility[vehicleIndex] = ComputeAudibility(vehicle, listeners);
+		AudibilityFrames[vehicleIndex] = GFrameCounter;
+	}
+
+	return Audibility[vehicleIndex];
+}
+
+/**
+* Play a one-shot sound attached to a vehicle, returning nullptr if it didn't fit in
+* the voice budget.
+***********************************************************************************/
+
+UAudioComponent* FVehicleAudioManager::PlaySoundAttached(USoundBase* sound, const ABaseVehicle* vehicle, USceneComponent* attachTo, float volume, float pitch)
+{
+	if (attachTo == nullptr)
+	{
+		return nullptr;
+	}
+
+	UAudioComponent* component = AllocateVoice(vehicle, sound);
+
+	if (component != nullptr)
+	{
+		component->bAllowSpatialization = true;
+		component->AttachToComponent(attachTo, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		component->SetSound(sound);
+		component->SetVolumeMultiplier(volume);
+		component->SetPitchMultiplier(pitch);
+		component->Play();
+	}
+
+	return component;
+}
+
+/**
+* Play a one-shot, non-spatialized sound for a vehicle, returning nullptr if it
+* didn't fit in the voice budget.
+***********************************************************************************/
+
+UAudioComponent* FVehicleAudioManager::PlaySound2D(USoundBase* sound, const ABaseVehicle* vehicle, float volume, float pitch)
+{
+	UAudioComponent* component = AllocateVoice(vehicle, sound);
+
+	if (component != nullptr)
+	{
+		component->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+		component->bAllowSpatialization = false;
+		component->SetSound(sound);
+		component->SetVolumeMultiplier(volume);
+		component->SetPitchMultiplier(pitch);
+		component->Play();
+	}
+
+	return component;
+}
+
+/**
+* Allocate a pooled audio component for a one-shot sound on a vehicle, returning
+* nullptr if it didn't fit in the voice budget.
+*
+* When the budget is spent the sound takes the voice of the least audible sound
+* playing, but only if it's more audible itself.
+***********************************************************************************/
+
+UAudioComponent* FVehicleAudioManager::AllocateVoice(const ABaseVehicle* vehicle, USoundBase* sound)
+{
+	if (sound == nullptr ||
+		vehicle == nullptr)
+	{
+		return nullptr;
+	}
+
+	float audibility = GetCurrentAudibility(vehicle);
+
+	if (audibility <= 0.0f)
+	{
+		return nullptr;
+	}
+
+	int32 index = INDEX_NONE;
+	int32 leastAudible = INDEX_NONE;
+
+	for (int32 i = 0; i < Components.Num(); i++)
+	{
+		if (Components[i]->IsPlaying() == false)
+		{
+			index = i;
+			break;
+		}
+
+		if (leastAudible == INDEX_NONE ||
+			ComponentAudibility[i] < ComponentAudibility[leastAudible])
+		{
+			leastAudible = i;
+		}
+	}
+
+	if (index == INDEX_NONE)
+	{
+		if (Components.Num() < MaxVoices)
+		{
+			UAudioComponent* component = NewObject<UAudioComponent>(vehicle->GetWorld()->GetWorldSettings());
+
+			component->bAutoActivate = false;
+			component->bAutoDestroy = false;
+			component->RegisterComponentWithWorld(vehicle->GetWorld());
+
+			index = Components.Emplace(component);
+
+			ComponentAudibility.Emplace(0.0f);
+		}
+		else if (ComponentAudibility[leastAudible] < audibility)
+		{
+			index = leastAudible;
+
+			Components[index]->Stop();
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	ComponentAudibility[index] = audibility;
+
+	return Components[index];
+}
+
+/**
+* Stop and release all of the pooled audio components.
+***********************************************************************************/
+
+void FVehicleAudioManager::Empty()
+{
+	for (UAudioComponent* component : Components)
+	{
+		if (GRIP_OBJECT_VALID(component) == true)
+		{
+			component->Stop();
+			component->DestroyComponent();
+		}
+	}
+
+	Components.Empty();
+	ComponentAudibility.Empty();
+}
@@ -47,6 +47,10 @@ public:
 		int32 ClampedNextIndex(int32 index) const
 	{ return (index + 1) % GetNumberOfSplinePoints(); }
 
+	// Get the distance along the spline nearest to a world location, optionally only
+	// searching a range either side of a hint distance.
+	float GetNearestDistance(const FVector& location, float hintDistance = -1.0f, float searchRange = 0.0f) const;
+
 	// Draw a box for debugging purposes.
 	UFUNCTION(BlueprintCallable, Category = AdvancedSpline)
 		void DrawBox(FBox const& Box, FColor const& Color)
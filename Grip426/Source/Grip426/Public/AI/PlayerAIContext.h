@@ -107,6 +107,9 @@ public:
 	bool PursuitSplineTransitionInProgress() const
 	{ return PursuitSplineFollowingRatio != 0.0f && PursuitSplineFollowingRatio != 1.0f; }
 
+	// Set the optimum and minimum speeds from a pursuit spline's speed profile.
+	void SetSpeedsFromSpline(const UPursuitSplineComponent* spline, float distance);
+
 	// Is the vehicle currently under bot control? If this flag is set, car may have been human at some point, but is a bot now (end of game for example).
 	bool BotDriver = false;
 
@@ -363,3 +366,124 @@ struct FVehicleAvoidableContext
 	// How quickly will they hit each other in seconds if running intersecting courses.
 	float AvoidableRanking;
 };
+
+/**
+* The immutable state of a vehicle, captured once per frame for the AI decision
+* pass to read from.
+***********************************************************************************/
+
+struct FVehicleAISnapshot
+{
+public:
+
+	// The location of the vehicle.
+	FVector Location = FVector::ZeroVector;
+
+	// The velocity of the vehicle, in centimeters per second.
+	FVector Velocity = FVector::ZeroVector;
+
+	// The direction the vehicle is traveling in, or facing if it's not moving.
+	FVector Direction = FVector::ForwardVector;
+
+	// The distance of the vehicle along the master racing spline, in centimeters.
+	float TrackDistance = 0.0f;
+
+	// The race position of the vehicle.
+	int32 RacePosition = -1;
+
+	// Is the vehicle driven by a human player?
+	bool Human = false;
+
+	// Is the vehicle currently destroyed?
+	bool Destroyed = false;
+
+	// Is there a vehicle at this index in the snapshot?
+	bool Valid = false;
+
+	// The vehicle's steering input, between -1 and +1.
+	float SteeringInput = 0.0f;
+
+	// The vehicle's throttle input, between -1 and +1.
+	float ThrottleInput = 0.0f;
+
+	// The vehicle's brake input, between 0 and 1.
+	float BrakeInput = 0.0f;
+
+	// The driving mode the vehicle's AI is in.
+	EVehicleAIDrivingMode DrivingMode = EVehicleAIDrivingMode::GeneralManeuvering;
+
+	// Where the vehicle's AI is heading towards.
+	FVector HeadingTo = FVector::ZeroVector;
+};
+
+/**
+* The immutable state of an avoidable, captured once per frame for the AI decision
+* pass to read from.
+***********************************************************************************/
+
+struct FAvoidableAISnapshot
+{
+public:
+
+	// The location of the avoidable.
+	FVector Location = FVector::ZeroVector;
+
+	// The velocity of the avoidable, in centimeters per second.
+	FVector Velocity = FVector::ZeroVector;
+
+	// The radius of the avoidable, in centimeters.
+	float Radius = 0.0f;
+};
+
+/**
+* The immutable state of the world, captured once per frame so that the decisions
+* for all of the AI bots can be made in parallel without touching live actors.
+***********************************************************************************/
+
+struct FAIWorldSnapshot
+{
+public:
+
+	// The frame number that the snapshot was taken on.
+	int32 FrameNumber = -1;
+
+	// The vehicles, indexed by vehicle index.
+	TArray<FVehicleAISnapshot> Vehicles;
+
+	// The avoidables that are currently active.
+	TArray<FAvoidableAISnapshot> Avoidables;
+};
+
+/**
+* The outcome of an AI bot's decision pass, written back to its vehicle once all of
+* the bots have decided.
+***********************************************************************************/
+
+struct FVehicleAIDecision
+{
+public:
+
+	// Is there a decision to apply?
+	bool Valid = false;
+
+	// The steering input, between -1 and +1.
+	float SteeringInput = 0.0f;
+
+	// The throttle input, between -1 and +1.
+	float ThrottleInput = 0.0f;
+
+	// The brake input, between 0 and 1.
+	float BrakeInput = 0.0f;
+
+	// The driving mode to be in.
+	EVehicleAIDrivingMode DrivingMode = EVehicleAIDrivingMode::GeneralManeuvering;
+
+	// Where the vehicle is heading towards.
+	FVector HeadingTo = FVector::ZeroVector;
+
+	// Are there any obstacles in front to stop us using the turbo?
+	bool TurboObstacles = false;
+
+	// Are there any non-vehicle obstacles in front to stop us using the turbo?
+	bool NonVehicleTurboObstacles = false;
+};
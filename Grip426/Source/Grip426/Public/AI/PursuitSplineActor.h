@@ -43,6 +43,14 @@ public:
 	UPROPERTY()
 		TArray<FPursuitPointExtendedData> PointExtendedData;
 
+	// The unfiltered point extended data, in parallel with PointExtendedData.
+	UPROPERTY()
+		TArray<FPursuitPointColdData> PointColdData;
+
+	// The environment distances for all of the extended points, NumDistances per point, in centimeters.
+	UPROPERTY()
+		TArray<uint16> EnvironmentDistances;
+
 	// Is this pursuit spline currently selected in the Editor?
 	UPROPERTY(Transient, BlueprintReadOnly, Category = Pursuit)
 		bool Selected;
@@ -65,4 +73,24 @@ public:
 
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "Default")
 		void UpdateVisualisation();
+
+	// Allocate the extended data for a number of points, all arrays kept in step.
+	void AllocateExtendedPointData(int32 numPoints);
+
+	// Get the environment distances for an extended point.
+	const uint16* GetEnvironmentDistances(int32 point) const
+	{ return EnvironmentDistances.GetData() + (point * FPursuitPointExtendedData::NumDistances); }
+
+	// Get an environment distance for an extended point, in centimeters.
+	float GetEnvironmentDistance(int32 point, int32 index) const
+	{ return (float)EnvironmentDistances[(point * FPursuitPointExtendedData::NumDistances) + index]; }
+
+	// Set the environment distances for an extended point from NumDistances samples in centimeters.
+	void SetEnvironmentDistances(int32 point, const float* distances);
+
+	// Does an extended point reside over level ground?
+	bool IsLevelGround(int32 point) const;
+
+	// Does an extended point reside under level ceiling?
+	bool IsLevelCeiling(int32 point) const;
 };
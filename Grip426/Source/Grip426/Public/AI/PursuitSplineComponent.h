@@ -19,6 +19,7 @@
 #include "system/gameconfiguration.h"
 #include "components/splinemeshcomponent.h"
 #include "ai/advancedsplinecomponent.h"
+#include "system/mathhelpers.h"
 #include "pursuitsplinecomponent.generated.h"
 
 class UPursuitSplineComponent;
@@ -111,6 +112,10 @@ public:
 
 /**
 * Structure for extended automatically-generated point data for pursuit splines.
+*
+* This is the hot data, read by the AI and weather systems every frame, and so is
+* kept as small as possible. The environment distances are stored in a flat block
+* on the owning actor and the raw, pre-filtered data in FPursuitPointColdData.
 ***********************************************************************************/
 
 USTRUCT(BlueprintType)
@@ -120,6 +125,15 @@ struct FPursuitPointExtendedData
 
 public:
 
+	// The orientation, cached here for speed.
+	UPROPERTY()
+		FQuat Quaternion = FQuat::Identity;
+
+	// Where is the ground relative to this point, in world space?
+	// NB. Ground is the closest point, not necessarily below.
+	UPROPERTY()
+		FVector UseGroundOffset = FVector::ZeroVector;
+
 	// The distance along the spline at which the point is found.
 	UPROPERTY()
 		float Distance = 0.0f;
@@ -133,10 +147,6 @@ public:
 	UPROPERTY()
 		float MaxTunnelDiameter = 0.0f;
 
-	// The raw, unfiltered exterior weather allowed to be rendered at this point? (< 1 means not)
-	UPROPERTY()
-		float RawWeatherAllowed = 0.0f;
-
 	// The filtered, more natural exterior weather allowed to be rendered at this point? (< 1 means not)
 	UPROPERTY()
 		float UseWeatherAllowed = 0.0f;
@@ -144,55 +154,113 @@ public:
 	// The index to identify the curvature of the spline in environment space.
 	// (i.e. which environment index would you naturally drive along).
 	UPROPERTY()
-		int32 CurvatureIndex = 0;
+		uint8 CurvatureIndex = 0;
 
-	// The raw, unfiltered ground index into the environment distances.
+	// The filtered, more natural ground index into the environment distances.
 	UPROPERTY()
-		int32 RawGroundIndex = 0;
+		uint8 UseGroundIndex = 0;
 
-	// The filtered, more natural ground index into the environment distances.
+	// Does the left-hand driving surface have open edge? (therefore, don't drive over it)
 	UPROPERTY()
-		int32 UseGroundIndex = 0;
+		bool OpenLeft = false;
 
-	// Where is the ground relative to this point, in world space?
-	// NB. Ground is the closest point, not necessarily below.
+	// Does the left-hand driving surface have open edge? (therefore, don't drive over it)
 	UPROPERTY()
-		FVector RawGroundOffset = FVector::ZeroVector;
+		bool OpenRight = false;
+
+	// Get the angle difference between to environment samples.
+	static float DifferenceInDegrees(int32 indexFrom, int32 indexTo);
+
+	// The number of environment distances what we sample and store.
+	static const int32 NumDistances = 32;
+
+	// The maximum environment distance we can store, in centimeters.
+	static const int32 MaxEnvironmentDistance = 0xffff;
+};
+
+/**
+* Structure for the cold, unfiltered extended point data for pursuit splines, only
+* ever used when building the filtered data.
+***********************************************************************************/
+
+USTRUCT(BlueprintType)
+struct FPursuitPointColdData
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
 
 	// Where is the ground relative to this point, in world space?
 	// NB. Ground is the closest point, not necessarily below.
 	UPROPERTY()
-		FVector UseGroundOffset = FVector::ZeroVector;
+		FVector RawGroundOffset = FVector::ZeroVector;
 
-	// How far away are the nearest objects to this point for a number of samples, in centimeters.
+	// The raw, unfiltered exterior weather allowed to be rendered at this point? (< 1 means not)
 	UPROPERTY()
-		TArray<float> EnvironmentDistances;
+		float RawWeatherAllowed = 0.0f;
 
-	// Does the left-hand driving surface have open edge? (therefore, don't drive over it)
+	// The raw, unfiltered ground index into the environment distances.
 	UPROPERTY()
-		bool OpenLeft = false;
+		uint8 RawGroundIndex = 0;
+};
 
-	// Does the left-hand driving surface have open edge? (therefore, don't drive over it)
-	UPROPERTY()
-		bool OpenRight = false;
+/**
+* An edge in the route graph, leading from a junction on a pursuit spline onto
+* another spline, or continuing along the same one.
+***********************************************************************************/
 
-	// The orientation, cached here for speed.
-	UPROPERTY()
-		FQuat Quaternion = FQuat::Identity;
+struct FRouteChoice
+{
+public:
 
-	// Does this point reside over level ground?
-	bool IsLevelGround()
-	{ return (EnvironmentDistances[UseGroundIndex] < 25.0f * 100.0f && UseGroundIndex >= (NumDistances >> 1) - (NumDistances >> 4) && UseGroundIndex <= (NumDistances >> 1) + (NumDistances >> 4)); }
+	// The spline that this choice leads onto, weak as it may be streamed out after the route graph is built.
+	TWeakObjectPtr<UPursuitSplineComponent> Spline;
 
-	// Does this point reside under level ceiling?
-	bool IsLevelCeiling()
-	{ return (EnvironmentDistances[UseGroundIndex] < 25.0f * 100.0f && (UseGroundIndex >= (NumDistances - (NumDistances >> 4)) || UseGroundIndex <= (NumDistances >> 4))); }
+	// The distance along Spline at which this choice joins it.
+	float Distance = 0.0f;
 
-	// Get the angle difference between to environment samples.
-	static float DifferenceInDegrees(int32 indexFrom, int32 indexTo);
+	// The length of the route until it rejoins the spline it left, or ends, in cm.
+	float Length = 0.0f;
 
-	// The number of environment distances what we sample and store.
-	static const int32 NumDistances = 32;
+	// The distance along the spline it left at which the route rejoins it, its length if it never does.
+	float RejoinDistance = 0.0f;
+
+	// The expected time to drive the length of the route, in seconds.
+	float ExpectedTime = 0.0f;
+
+	// The value of the pickups to be found along the route, 0 for none.
+	float PickupValue = 0.0f;
+
+	// The minimum difficulty level at which bots will take this route.
+	int32 MinimumDifficultyLevel = 0;
+
+	// Is the spline that this choice leads onto still present and enabled?
+	bool IsEnabled() const
+	{ return (Spline.IsValid() == true && Spline->Enabled == true); }
+};
+
+/**
+* A node in the route graph, where one or more branches leave a pursuit spline.
+***********************************************************************************/
+
+struct FRouteJunction
+{
+public:
+
+	// The number of difficulty levels we build choice tables for.
+	static const int32 NumDifficultyLevels = 4;
+
+	// The number of entries in each choice table.
+	static const int32 ChoiceTableSize = 32;
+
+	// The distance along the spline at which the junction is found.
+	float Distance = 0.0f;
+
+	// The route choices available at this junction.
+	TArray<FRouteChoice> Choices;
+
+	// Weighted choice tables for each difficulty level, each entry indexing into Choices.
+	uint8 ChoiceTable[NumDifficultyLevels][ChoiceTableSize];
 };
 
 /**
@@ -245,16 +313,59 @@ public:
 	// Get the optimum speed at a point along a spline.
 	UFUNCTION(BlueprintCallable, Category = Spline)
 		float GetOptimumSpeedAtSplinePoint(int32 point) const
-	{ return 0.0f; }
+	{ return GetOptimumSpeedAtDistance(GetDistanceAlongSplineAtSplinePoint(point)); }
 
 	// Get the minimum speed at a point along a spline.
 	UFUNCTION(BlueprintCallable, Category = Spline)
 		float GetMinimumSpeedAtSplinePoint(int32 point) const
-	{ return 0.0f; }
+	{ return GetMinimumSpeedAtDistance(GetDistanceAlongSplineAtSplinePoint(point)); }
+
+	// Get the optimum speed in KPH (0 for full throttle) at a distance along the spline.
+	float GetOptimumSpeedAtDistance(float distance) const
+	{ return GetSpeedProfileAtDistance(OptimumSpeedProfile, distance); }
+
+	// Get the minimum speed in KPH (0 for none) at a distance along the spline.
+	float GetMinimumSpeedAtDistance(float distance) const
+	{ return GetSpeedProfileAtDistance(MinimumSpeedProfile, distance); }
+
+	// Build the optimum and minimum speed profiles for the spline.
+	void BuildSpeedProfile(float lateralGrip, float acceleration, float braking, float maximumSpeed);
+
+	// Get the expected time in seconds to drive between two distances along the spline.
+	float GetExpectedTime(float fromDistance, float toDistance, float maximumSpeed) const;
+
+	// Get the next route junction at or beyond a distance along the spline, or nullptr if none.
+	const FRouteJunction* GetNextRouteJunction(float distance) const;
+
+	// Choose a route at a junction for a difficulty level, or nullptr if no choice is enabled.
+	const FRouteChoice* ChooseRoute(const FRouteJunction& junction, int32 difficultyLevel, FMathEx::FRandomFast& random) const;
 
 	UFUNCTION(BlueprintCallable, Category = Spline)
 		void EmptySplineMeshes()
 	{ }
+
+	// The distance between samples in the speed profiles, in centimeters.
+	UPROPERTY()
+		float SpeedProfileSpacing = 500.0f;
+
+	// The optimum speed in KPH (0 for full throttle) every SpeedProfileSpacing along the spline.
+	UPROPERTY()
+		TArray<float> OptimumSpeedProfile;
+
+	// The minimum speed in KPH (0 for none) every SpeedProfileSpacing along the spline.
+	UPROPERTY()
+		TArray<float> MinimumSpeedProfile;
+
+	// The route junctions along this spline in order of distance, built once per level.
+	TArray<FRouteJunction> RouteJunctions;
+
+private:
+
+	// Get the lateral curvature of the spline at a distance along it, in 1 / cm.
+	float GetLateralCurvatureAtDistance(float distance, float sampleDistance) const;
+
+	// Get a value from a speed profile at a distance along the spline.
+	float GetSpeedProfileAtDistance(const TArray<float>& profile, float distance) const;
 };
 
 /**
@@ -17,6 +17,7 @@
 
 #include "system/gameconfiguration.h"
 #include "system/mathhelpers.h"
+#include "worldcollision.h"
 #include "flippablespringarmcomponent.generated.h"
 
 /**
@@ -93,6 +94,10 @@ public:
 	UPROPERTY(EditAnywhere, Category = Arm)
 		float ProbeSize = 10.0f;
 
+	// How far the arm needs to have moved since the last collision probe before it's probed again (in unreal units).
+	UPROPERTY(EditAnywhere, Category = Arm)
+		float ProbeSkipDistance = 5.0f;
+
 	// What yaw extension to use?
 	UPROPERTY(EditAnywhere, Category = Arm)
 		float DriftYawExtension = -1.0f;
@@ -124,8 +129,30 @@ public:
 	// The name of the socket at the end of the spring arm (looking back towards the spring arm origin)
 	static const FName SocketName;
 
+	// Get the camera location on an arm after collision, from an asynchronous probe issued on the previous frame.
+	FVector ProbeArm(const FVector& pivot, const FVector& desired, const FVector& velocity, float deltaSeconds);
+
+	// Reset the collision probe, on a camera cut for example.
+	void ResetProbe()
+	{ ProbeHandle.Invalidate(); ProbeIssued = false; ProbeFraction = 1.0f; }
+
 private:
 
+	// The handle for the collision probe in flight.
+	FTraceHandle ProbeHandle;
+
+	// Has a collision probe been issued since the last reset?
+	bool ProbeIssued = false;
+
+	// The pivot location the last collision probe was issued from.
+	FVector ProbePivot = FVector::ZeroVector;
+
+	// The desired camera location the last collision probe was issued to.
+	FVector ProbeDesired = FVector::ZeroVector;
+
+	// The fraction of the arm that was found to be clear by the last collision probe.
+	float ProbeFraction = 1.0f;
+
 	friend class ADebugRaceCameraHUD;
 	friend class ADebugVehicleHUD;
 };
@@ -19,6 +19,35 @@
 #include "ai/pursuitsplineactor.h"
 #include "statictrackcamera.generated.h"
 
+/**
+* The visibility of the track from a camera, baked against the master racing spline
+* of a single navigation layer.
+***********************************************************************************/
+
+USTRUCT()
+struct FTrackCameraVisibility
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// The navigation layer whose master racing spline the visibility was baked against.
+	UPROPERTY()
+		FName NavigationLayer;
+
+	// The baked visibility, one byte per bucket along the master racing spline with a bit for each lane.
+	UPROPERTY()
+		TArray<uint8> Bits;
+
+	// The length of each bucket when the visibility was baked, in centimeters.
+	UPROPERTY()
+		float BucketLength = 0.0f;
+
+	// The width of the track either side of the master racing spline when the visibility was baked, in centimeters.
+	UPROPERTY()
+		float TrackWidth = 0.0f;
+};
+
 /**
 * Track camera actor for placing camera views around tracks.
 ***********************************************************************************/
@@ -48,20 +77,74 @@ public:
 	UPROPERTY(EditAnywhere, Category = TrackCamera)
 		int32 NumberOfVehicles = 3;
 
+	// The distance before the camera along the master racing spline, in meters, in which vehicles are detected coming towards it.
+	UPROPERTY(EditAnywhere, Category = TrackCamera)
+		float DetectionDistanceBefore = 100.0f;
+
+	// The distance after the camera along the master racing spline, in meters, in which vehicles are still detected.
+	UPROPERTY(EditAnywhere, Category = TrackCamera)
+		float DetectionDistanceAfter = 10.0f;
+
 	// Only detect vehicles on the closest pursuit spline to this camera.
 	UPROPERTY(EditAnywhere, Category = TrackCamera)
 		bool LinkToClosestPursuitSpline = false;
 
+	// The distance along the master racing spline of the camera, in centimeters, assigned at level start.
+	float DistanceAlongMasterRacingSpline = 0.0f;
+
 	// Is this camera indestructible and cannot be damaged?
 	UPROPERTY(EditAnywhere, Category = TrackCamera)
 		bool Indestructible = false;
 
+	// The length of each bucket along the master racing spline for the baked visibility, in meters.
+	UPROPERTY(EditAnywhere, Category = Visibility)
+		float VisibilityBucketLength = 10.0f;
+
+	// The width of the track either side of the master racing spline to bake the visibility across, in meters.
+	UPROPERTY(EditAnywhere, Category = Visibility)
+		float VisibilityTrackWidth = 30.0f;
+
+	// The maximum distance from the camera to bake the visibility for, in meters.
+	UPROPERTY(EditAnywhere, Category = Visibility)
+		float VisibilityRange = 300.0f;
+
+	// The navigation layer to bake the visibility for, none for the default layer.
+	UPROPERTY(EditAnywhere, Category = Visibility)
+		FName VisibilityNavigationLayer;
+
 	// Respond to a vehicle hitting the camera, often by throwing it off its mount and onto the track.
 	UFUNCTION()
 		void OnVehicleHit(class UPrimitiveComponent* hitComponent, class AActor* otherActor, class UPrimitiveComponent* otherComponent, int32 otherBodyIndex, bool fromSweep, const FHitResult& sweepResult);
 
+	// Bake the visibility of the track from the camera, against the master racing spline of VisibilityNavigationLayer.
+	UFUNCTION(CallInEditor, Category = Visibility)
+		void BakeVisibility();
+
+	// Select the baked visibility to use for the navigation layer of the current game.
+	void SelectVisibility(const FName& navigationLayer);
+
+	// Is a location on the track potentially visible from the camera, according to the baked visibility?
+	bool IsTrackVisible(float distance, float lateral) const;
+
+	// Is a location on the track visible from the camera, testing the baked visibility and then confirming with a trace?
+	bool CanSeeTrackLocation(const FVector& location, float distance, float lateral) const;
+
+	// The number of buckets across the track for the baked visibility, one bit each.
+	static const int32 NumVisibilityLanes = 8;
+
 private:
 
+	// Get the lane across the track for the baked visibility from a lateral offset.
+	static int32 GetVisibilityLane(const FTrackCameraVisibility& visibility, float lateral)
+	{ return FMath::Clamp(FMath::FloorToInt(((lateral / visibility.TrackWidth) + 1.0f) * 0.5f * NumVisibilityLanes), 0, NumVisibilityLanes - 1); }
+
+	// The baked visibility for each of the navigation layers it's been baked for.
+	UPROPERTY()
+		TArray<FTrackCameraVisibility> BakedVisibility;
+
+	// The index into BakedVisibility for the navigation layer of the current game, INDEX_NONE if it wasn't baked.
+	int32 VisibilityIndex = INDEX_NONE;
+
 	// Collision box to detect vehicles impacting the camera.
 	UPROPERTY(Transient)
 		UBoxComponent* CollisionBox = nullptr;
@@ -95,8 +95,8 @@ public:
 	UPROPERTY(EditAnywhere, Category = Streak, meta = (EditCondition = "Streak"))
 		FMinMax Deviation = FMinMax(0.15f, 0.25f);
 
-	// The maximum number of points used to render each electrical tendril.
-	UPROPERTY(EditAnywhere, Category = Streak, meta = (EditCondition = "Streak"))
+	// The maximum number of points used to render each electrical tendril, limited to the number of points in the pre-generated noise paths.
+	UPROPERTY(EditAnywhere, Category = Streak, meta = (EditCondition = "Streak", UIMin = "2", UIMax = "257", ClampMin = "2", ClampMax = "257"))
 		int32 NumPoints = 256;
 
 	// The number of meters between each point.
@@ -190,6 +190,12 @@ public:
 	// Are strikes currently enabled?
 	bool StrikesEnabled = true;
 
+	// Enable or disable strikes, stopping the component from ticking at all while they're disabled.
+	void SetStrikesEnabled(bool enabled);
+
+	// Generate the points for a tendril between two world locations, from one of the pre-generated noise paths.
+	void GenerateTendril(const FVector& start, const FVector& end, TArray<FVector>& points) const;
+
 	// The particle system for the effect.
 	UPROPERTY(Transient)
 		UProceduralMeshComponent* Geometry = nullptr;
@@ -207,6 +213,20 @@ public:
 
 	// The standard material to be used for flares.
 	static UMaterialInterface* StandardFlareMaterial;
+
+	// The number of pre-generated noise paths that tendrils are selected from.
+	static const int32 NumNoisePaths = 32;
+
+	// The number of points in each pre-generated noise path, which must be a power of 2 plus 1, and at least the maximum NumPoints.
+	static const int32 NumNoisePathPoints = 257;
+
+private:
+
+	// Generate the noise paths shared by all of the tendrils, if they haven't been already.
+	static void GenerateNoisePaths();
+
+	// The noise paths, each running from 0 to 1 along X with a maximum deviation of 1 in Y and Z.
+	static TArray<FVector> NoisePaths;
 };
 
 /**
@@ -259,6 +279,9 @@ public:
 	UPROPERTY(VisibleAnywhere, Category = Generator, meta = (AllowPrivateaccess = "true"))
 		UPointLightComponent* EndLocationLight = nullptr;
 
+	// Cache the streak and light components once they've all been created.
+	virtual void PostInitializeComponents() override;
+
 	// Enable electrical strikes.
 	UFUNCTION(BlueprintCallable, Category = Generator)
 		void EnableStrikes() const;
@@ -278,4 +301,12 @@ public:
 	// The point lights used in rendering the electricity.
 	UPROPERTY(Transient)
 		TArray<UPointLightComponent*> AdditionalPointLights;
+
+	// All of the streak components on the generator, cached at initialization.
+	UPROPERTY(Transient, BlueprintReadOnly, Category = Generator)
+		TArray<UElectricalStreakComponent*> Streaks;
+
+	// All of the point light components on the generator, cached at initialization.
+	UPROPERTY(Transient, BlueprintReadOnly, Category = Generator)
+		TArray<UPointLightComponent*> PointLights;
 };
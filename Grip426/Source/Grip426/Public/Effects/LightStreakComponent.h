@@ -183,6 +183,14 @@ public:
 	// Set the controlling global amount for alpha and lifetime.
 	void SetGlobalAmount(float alphaAmount, float lifeTimeAmount);
 
+	// Get the controlling global amount for alpha.
+	float GetGlobalAlphaAmount() const
+	{ return GlobalAlphaAmount; }
+
+	// Get the controlling global amount for lifetime.
+	float GetGlobalLifeTimeAmount() const
+	{ return GlobalLifeTimeAmount; }
+
 	// The particle system for the effect.
 	UPROPERTY(Transient)
 		UProceduralMeshComponent* Geometry = nullptr;
@@ -204,6 +212,36 @@ public:
 
 	// The standard material to be used for flares.
 	static UMaterialInterface* StandardFlareMaterial;
+
+	// The name of the color parameter in streak and flare materials.
+	static const FName ColourParameterName;
+
+	// The name of the end color parameter in streak materials.
+	static const FName EndColourParameterName;
+
+	// The name of the texture parameter in flare materials.
+	static const FName TextureParameterName;
+
+protected:
+
+	// Register the streak with the light streak manager.
+	virtual void BeginPlay() override;
+
+	// Unregister the streak from the light streak manager.
+	virtual void EndPlay(const EEndPlayReason::Type endPlayReason) override;
+
+private:
+
+	// The controlling global amount for alpha.
+	float GlobalAlphaAmount = 1.0f;
+
+	// The controlling global amount for lifetime.
+	float GlobalLifeTimeAmount = 1.0f;
+
+	// The index of the slot for the streak in the light streak manager, or INDEX_NONE.
+	int32 StreakSlot = INDEX_NONE;
+
+	friend struct FLightStreakManager;
 };
 
 /**
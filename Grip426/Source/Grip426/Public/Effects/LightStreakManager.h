@@ -0,0 +1,239 @@
+/**
+*
+* Light streak manager.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Updates all of the light streaks in the game in a single pass, rather than each
+* light streak component ticking on its own. The points for every streak are kept
+* in one arena, split into fixed-size ring buffers, and the geometry for all of the
+* streaks and flares is built into a procedural mesh for each local player's view,
+* with one section for each material.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+#include "proceduralmeshcomponent.h"
+#include "lightstreakmanager.generated.h"
+
+class ULightStreakComponent;
+
+DECLARE_LOG_CATEGORY_EXTERN(GripLogLightStreaks, Log, All);
+
+/**
+* A point along a light streak.
+***********************************************************************************/
+
+struct FLightStreakPoint
+{
+public:
+
+	// The world location of the point.
+	FVector Location = FVector::ZeroVector;
+
+	// The up vector of the streak at the point, for when it's not camera facing.
+	FVector Up = FVector::UpVector;
+
+	// The time the point has been alive for, in seconds.
+	float Age = 0.0f;
+
+	// The alpha of the streak when the point was added.
+	float Alpha = 0.0f;
+};
+
+/**
+* A light streak registered with the manager, and its ring buffer in the arena.
+***********************************************************************************/
+
+struct FLightStreakSlot
+{
+public:
+
+	// The component for the streak, or nullptr if the slot is free.
+	TWeakObjectPtr<ULightStreakComponent> Component;
+
+	// The index of the first point of the ring buffer in the arena.
+	int32 FirstPoint = 0;
+
+	// The index within the ring buffer of the newest point.
+	int32 Head = 0;
+
+	// The number of live points in the ring buffer.
+	int32 NumPoints = 0;
+
+	// The location of the component on the last update.
+	FVector LastLocation = FVector::ZeroVector;
+
+	// The direction of the streak when its last point was added.
+	FVector LastDirection = FVector::ZeroVector;
+
+	// The time the streak has been registered for, in seconds.
+	float Age = 0.0f;
+
+	// The alpha of the streak on the last update.
+	float Alpha = 0.0f;
+
+	// Was the streak visible on the last update?
+	bool Visible = false;
+};
+
+/**
+* The geometry for one material, built up over a frame.
+***********************************************************************************/
+
+struct FLightStreakSection
+{
+public:
+
+	// The material for the section.
+	UMaterialInterface* Material = nullptr;
+
+	// The vertex positions.
+	TArray<FVector> Vertices;
+
+	// The triangle indices.
+	TArray<int32> Triangles;
+
+	// The vertex texture coordinates.
+	TArray<FVector2D> UVs;
+
+	// The vertex colors.
+	TArray<FLinearColor> Colors;
+
+	// Reset the geometry, keeping the allocations.
+	void Reset()
+	{ Vertices.Reset(); Triangles.Reset(); UVs.Reset(); Colors.Reset(); }
+
+	// Add a quad to the geometry.
+	void AddQuad(const FVector& v0, const FVector& v1, const FVector& v2, const FVector& v3, const FLinearColor& c0, const FLinearColor& c1, float u0 = 0.0f, float u1 = 1.0f);
+};
+
+/**
+* The geometry built for a single local player's view, facing its camera.
+***********************************************************************************/
+
+struct FLightStreakView
+{
+public:
+
+	// The player controller for the view, or nullptr if there isn't one.
+	TWeakObjectPtr<APlayerController> Controller;
+
+	// The location of the camera for the view.
+	FVector CameraLocation = FVector::ZeroVector;
+
+	// The geometry sections, one for each material in use.
+	TArray<FLightStreakSection> Sections;
+};
+
+/**
+* The properties that identify a shared dynamic material for streaks or flares.
+***********************************************************************************/
+
+struct FLightStreakMaterialKey
+{
+public:
+
+	// The parent material.
+	UMaterialInterface* Parent = nullptr;
+
+	// The texture, if any.
+	UTexture* Texture = nullptr;
+
+	// The color.
+	FLinearColor Colour = FLinearColor::White;
+
+	// The end color.
+	FLinearColor EndColour = FLinearColor::White;
+
+	bool operator == (const FLightStreakMaterialKey& other) const
+	{ return Parent == other.Parent && Texture == other.Texture && Colour == other.Colour && EndColour == other.EndColour; }
+
+	friend uint32 GetTypeHash(const FLightStreakMaterialKey& key)
+	{ return HashCombine(HashCombine(GetTypeHash(key.Parent), GetTypeHash(key.Texture)), HashCombine(GetTypeHash(key.Colour), GetTypeHash(key.EndColour))); }
+};
+
+/**
+* Manager for updating and rendering all of the light streaks in a game.
+***********************************************************************************/
+
+USTRUCT()
+struct FLightStreakManager
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// Register a light streak to be updated and rendered, returning false if there's no room for it.
+	bool AddStreak(ULightStreakComponent* component);
+
+	// Unregister a light streak, freeing its ring buffer.
+	void RemoveStreak(ULightStreakComponent* component);
+
+	// Update all of the streaks and rebuild their geometry.
+	void Tick(UWorld* world, AActor* owner, float deltaSeconds);
+
+	// Remove all of the streaks and their geometry.
+	void Empty();
+
+	// The number of points in the ring buffer of each streak.
+	static const int32 PointsPerStreak = 32;
+
+	// The maximum number of streaks that can be registered at once.
+	static const int32 MaxStreaks = 256;
+
+	// The number of streaks that couldn't be registered because the manager was full.
+	int32 NumOverflows = 0;
+
+private:
+
+	// Match the views to the local players, each player only seeing its own view's geometry.
+	void UpdateViews(UWorld* world, AActor* owner);
+
+	// Update the points for a streak, returning its current alpha.
+	float UpdatePoints(FLightStreakSlot& slot, ULightStreakComponent* component, float deltaSeconds);
+
+	// Add the geometry for a streak to the section for its material.
+	void AddStreakGeometry(FLightStreakView& view, const FLightStreakSlot& slot, ULightStreakComponent* component);
+
+	// Add the geometry for the flares of a streak to the sections for their materials.
+	void AddFlareGeometry(FLightStreakView& view, ULightStreakComponent* component, float alpha);
+
+	// Get the section for a material within a view, adding one if necessary.
+	FLightStreakSection& GetSection(FLightStreakView& view, UMaterialInterface* material);
+
+	// Get a shared dynamic material with the given parameters, creating it if necessary.
+	UMaterialInstanceDynamic* GetMaterial(UMaterialInterface* parent, UTexture* texture, const FLinearColor& colour, const FLinearColor& endColour);
+
+	// Get a point in the ring buffer of a streak, 0 being the newest.
+	FLightStreakPoint& GetPoint(const FLightStreakSlot& slot, int32 index)
+	{ return Points[slot.FirstPoint + ((slot.Head - index + PointsPerStreak) % PointsPerStreak)]; }
+
+	// The arena holding the ring buffers of points for all of the streaks.
+	TArray<FLightStreakPoint> Points;
+
+	// The streak slots, each owning a ring buffer in the arena.
+	TArray<FLightStreakSlot> Slots;
+
+	// The indices of the slots that are free for use.
+	TArray<int32> FreeSlots;
+
+	// The views, one for each local player.
+	TArray<FLightStreakView> Views;
+
+	// The meshes the streaks and flares are rendered with, one for each view.
+	UPROPERTY(Transient)
+		TArray<UProceduralMeshComponent*> Geometries;
+
+	// The dynamic materials shared between streaks with the same parameters, held here to keep them referenced.
+	UPROPERTY(Transient)
+		TArray<UMaterialInstanceDynamic*> Materials;
+
+	// The dynamic materials shared between streaks, keyed by their parameters.
+	TMap<FLightStreakMaterialKey, UMaterialInstanceDynamic*> MaterialsByKey;
+};
@@ -107,6 +107,12 @@ public:
 	// The number of checkpoints reached.
 	int32 CheckpointsReached = 0;
 
+	// The location of the vehicle at the end of the last checkpoint update, where the next sweep starts from.
+	FVector CheckpointSweepLocation = FVector::ZeroVector;
+
+	// Is CheckpointSweepLocation valid yet?
+	bool CheckpointSweepValid = false;
+
 	// The progressive distance traveled around the track based on the main spline progression, in centimeters.
 	float RaceDistance = 0.0f;
 	float EternalRaceDistance = 0.0f;
@@ -17,6 +17,7 @@
 #include "system/gameconfiguration.h"
 #include "gameframework/gamemode.h"
 #include "game/globalgamestate.h"
+#include "effects/lightstreakmanager.h"
 #include "basegamemode.generated.h"
 
 /**
@@ -103,6 +104,10 @@ public:
 	// Get the name of a player.
 	static FString GetPlayerName(class APlayerState* player, int32 playerNumber, bool upperCase = false, bool forceGeneric = false);
 
+	// Get the manager for updating and rendering all of the light streaks.
+	FLightStreakManager& GetLightStreakManager()
+	{ return LightStreakManager; }
+
 	// Get the base game mode for the current world.
 	static ABaseGameMode* Get(const UObject* worldContextObject)
 	{ return (worldContextObject == nullptr) ? nullptr : Cast<ABaseGameMode>(UGameplayStatics::GetGameMode(worldContextObject)); }
@@ -123,6 +128,9 @@ protected:
 	// Do some initialization when the game is ready to play.
 	virtual void BeginPlay() override;
 
+	// Do some shutdown when the actor is being destroyed.
+	virtual void EndPlay(const EEndPlayReason::Type endPlayReason) override;
+
 	// Do the regular update tick.
 	virtual void Tick(float deltaSeconds) override;
 
@@ -169,6 +177,10 @@ protected:
 	UPROPERTY(Transient)
 		TArray<APostProcessVolume*> PostProcessVolumes;
 
+	// The manager for updating and rendering all of the light streaks, in both menus and play.
+	UPROPERTY(Transient)
+		FLightStreakManager LightStreakManager;
+
 	// Naked pointer to game state for performance reasons.
 	UPROPERTY(Transient)
 		UGlobalGameState* GlobalGameState = nullptr;
@@ -20,6 +20,10 @@
 #include "system/mathhelpers.h"
 #include "system/timeshareclock.h"
 #include "system/avoidable.h"
+#include "system/actorpool.h"
+#include "vehicle/vehicleaudio.h"
+#include "pickups/missilemanager.h"
+#include "pickups/gunroundmanager.h"
 #include "gamemodes/basegamemode.h"
 #include "effects/drivingsurfacecharacteristics.h"
 #include "pickups/pickup.h"
@@ -102,9 +106,251 @@ public:
 	UPROPERTY(Transient, BlueprintReadOnly, Category = Event)
 		EGameEventType EventType = EGameEventType::Unknown;
 
-	// Additional textual information for this event.
+	// Is this event of interest to the HUD?
 	UPROPERTY(Transient, BlueprintReadOnly, Category = Event)
-		FString ExtraInformation;
+		bool OfInterest = false;
+
+	// The ID of the interned string holding additional textual information for this event, or -1 for none.
+	UPROPERTY(Transient, BlueprintReadOnly, Category = Event)
+		int32 ExtraInformation = -1;
+};
+
+/**
+* Types for race events, changes to the race state of a vehicle that other systems
+* may want to respond to.
+***********************************************************************************/
+
+enum class ERaceEventType : uint8
+{
+	LapCompleted,
+	PositionChanged,
+	Eliminated,
+	Finished,
+	WeaponHit,
+	Num
+};
+
+/**
+* A race event, queued when published and dispatched in a batch once per frame.
+***********************************************************************************/
+
+struct FRaceEvent
+{
+public:
+
+	FRaceEvent() = default;
+
+	FRaceEvent(ERaceEventType type, int32 vehicleIndex, int32 value = 0, int32 otherVehicleIndex = -1)
+		: Type(type)
+		, VehicleIndex(vehicleIndex)
+		, OtherVehicleIndex(otherVehicleIndex)
+		, Value(value)
+	{ }
+
+	// The type of the event.
+	ERaceEventType Type = ERaceEventType::LapCompleted;
+
+	// The index of the vehicle that the event happened to.
+	int32 VehicleIndex = -1;
+
+	// The index of another vehicle involved, the launching vehicle for weapon hits.
+	int32 OtherVehicleIndex = -1;
+
+	// The lap number, race position or pickup type, depending on the type of the event.
+	int32 Value = 0;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FRaceEventDelegate, const FRaceEvent&);
+
+/**
+* The track-space coordinate frame for an actor, relative to the master racing
+* spline.
+***********************************************************************************/
+
+struct FTrackFrame
+{
+public:
+
+	// The actor that the frame is for.
+	AActor* Actor = nullptr;
+
+	// The location of the actor when the frame was computed.
+	FVector Location = FVector::ZeroVector;
+
+	// The distance along the master racing spline, in centimeters.
+	float Distance = 0.0f;
+
+	// The offset to the right of the master racing spline, in centimeters.
+	float Lateral = 0.0f;
+
+	// The offset above the master racing spline, in centimeters.
+	float Vertical = 0.0f;
+
+	// The direction of the master racing spline at Distance.
+	FVector Forward = FVector::ForwardVector;
+
+	// The right vector of the master racing spline at Distance.
+	FVector Right = FVector::RightVector;
+
+	// The up vector of the master racing spline at Distance.
+	FVector Up = FVector::UpVector;
+};
+
+/**
+* An interval of the master racing spline in which a track camera detects vehicles.
+* Intervals that wrap around the start of the spline are split in two.
+***********************************************************************************/
+
+struct FTrackCameraInterval
+{
+public:
+
+	// The start distance along the master racing spline, in centimeters.
+	float StartDistance = 0.0f;
+
+	// The end distance along the master racing spline, in centimeters.
+	float EndDistance = 0.0f;
+
+	// The index of the camera in TrackCameras.
+	int32 CameraIndex = 0;
+};
+
+/**
+* A snapshot of the race for rendering on the HUD, taken once per frame and shared
+* between all of the HUD bindings for all of the local players. Indexed by vehicle
+* index.
+***********************************************************************************/
+
+struct FHUDRaceSnapshot
+{
+public:
+
+	// The frame number that the snapshot was taken on.
+	int32 FrameNumber = -1;
+
+	// The race distance for each vehicle, in centimeters.
+	float RaceDistances[GRIP_MAX_PLAYERS];
+
+	// The scale in meters for rendering the race positions with each vehicle as the viewer.
+	int32 PackScales[GRIP_MAX_PLAYERS];
+
+	// The color of the race position indicator for each vehicle.
+	FLinearColor Colours[GRIP_MAX_PLAYERS];
+
+	// Is each vehicle present in the game?
+	bool Present[GRIP_MAX_PLAYERS];
+
+	// Is each vehicle destroyed?
+	bool Destroyed[GRIP_MAX_PLAYERS];
+};
+
+/**
+* Statistics on the pack of vehicles, computed once per frame from the sorted race
+* distances, along with the catch-up scalars evaluated from them for every vehicle.
+* Indexed by vehicle index, with the per-vehicle arrays padded for vector access.
+***********************************************************************************/
+
+struct FPackStatistics
+{
+public:
+
+	// The number of vehicle entries padded up to a whole number of vector registers.
+	static const int32 NumPadded = (GRIP_MAX_PLAYERS + 3) & ~3;
+
+	// The frame number that the statistics were computed on.
+	int32 FrameNumber = -1;
+
+	// The number of vehicles in the pack, excluding those destroyed.
+	int32 NumVehicles = 0;
+
+	// The number of human players in the pack.
+	int32 NumHumans = 0;
+
+	// The indices of the vehicles in the pack sorted by race distance, leader first.
+	int32 Order[GRIP_MAX_PLAYERS];
+
+	// The race distance of the leading vehicle, in centimeters.
+	float Front = 0.0f;
+
+	// The race distance of the trailing vehicle, in centimeters.
+	float Rear = 0.0f;
+
+	// The mean race distance of all of the vehicles, in centimeters.
+	float Centre = 0.0f;
+
+	// The mean race distance of the AI bots, or of all of the vehicles if there are none, in centimeters.
+	float BotCentre = 0.0f;
+
+	// The mean race distance of the human players, in centimeters.
+	float HumanCentre = 0.0f;
+
+	// The race distance of the leading human player, in centimeters.
+	float HumanFront = 0.0f;
+
+	// The race distance of the trailing human player, in centimeters.
+	float HumanRear = 0.0f;
+
+	// The race distance that the catch-up aims to congregate the AI bots around, in centimeters.
+	float TargetCentre = 0.0f;
+
+	// The race distance for each vehicle, in centimeters.
+	alignas(16) float RaceDistances[NumPadded];
+
+	// The distance each vehicle leads its catch-up centre by, the bot centre for humans and the target centre for bots, negative for trailing, in centimeters.
+	alignas(16) float LeadDistances[NumPadded];
+
+	// The catch-up ratio for each vehicle, -1 for maximum speedup at the rear and 1 for maximum slowdown at the front.
+	alignas(16) float CatchupRatios[NumPadded];
+
+	// The scale to apply to the drag of each vehicle.
+	alignas(16) float DragScales[NumPadded];
+
+	// The scale to apply to the grip of each vehicle.
+	alignas(16) float GripScales[NumPadded];
+
+	// The scale to apply to the low-speed acceleration of each vehicle.
+	alignas(16) float AccelerationScales[NumPadded];
+
+	// The aggression of each vehicle in using offensive weapons against unknown opponents, from 0 timid to 1 aggressive.
+	alignas(16) float WeaponAggression[NumPadded];
+
+	// Is each vehicle a human player?
+	bool Human[GRIP_MAX_PLAYERS];
+
+	// Is each vehicle present in the pack?
+	bool Present[GRIP_MAX_PLAYERS];
+};
+
+/**
+* The projection from world space to HUD widget space for a local player's view,
+* built once per frame and shared between everything on the HUD that needs to
+* project world locations.
+***********************************************************************************/
+
+struct FHUDProjectionContext
+{
+public:
+
+	// The frame number that the context was built on.
+	int32 FrameNumber = -1;
+
+	// Is the context valid for projection?
+	bool Valid = false;
+
+	// The combined view and projection matrix for the view.
+	FMatrix ViewProjectionMatrix = FMatrix::Identity;
+
+	// The location of the view in world space.
+	FVector ViewLocation = FVector::ZeroVector;
+
+	// The size of the player's viewport, in pixels.
+	FVector2D ViewportSize = FVector2D::ZeroVector;
+
+	// The DPI scale applied to the viewport for widgets.
+	float DPIScale = 1.0f;
+
+	// The clipping rectangle for the viewport, in widget space.
+	FMathEx::FRectangle WidgetRectangle = { FVector2D::ZeroVector, FVector2D::ZeroVector };
 };
 
 /**
@@ -514,9 +760,29 @@ public:
 	UPROPERTY(Transient, BlueprintReadWrite, Category = "System")
 		bool StopWhatYouDoing = false;
 
-	// The events that have occurred during this particular game event.
-	UPROPERTY(Transient, BlueprintReadOnly, Category = "System")
-		TArray<FGameEvent> GameEvents;
+	// Get the number of game events retained, the most recent MaxGameEvents at most.
+	UFUNCTION(BlueprintCallable, Category = "System")
+		int32 GetNumGameEvents() const
+	{ return (int32)FMath::Min<uint32>(NumGameEventsAdded, MaxGameEvents); }
+
+	// Get the text for an interned game event string.
+	UFUNCTION(BlueprintCallable, Category = "System")
+		FString GetGameEventString(int32 id) const
+	{ return (GameEventStrings.IsValidIndex(id) == true) ? GameEventStrings[id] : FString(); }
+
+	// Get a retained game event, 0 being the oldest, or a default event if none.
+	UFUNCTION(BlueprintCallable, Category = "System")
+		FGameEvent GetGameEventByIndex(int32 index) const
+	{ const FGameEvent* gameEvent = GetGameEvent(index); return (gameEvent != nullptr) ? *gameEvent : FGameEvent(); }
+
+	// Get the number of events of interest retained for a vehicle.
+	UFUNCTION(BlueprintCallable, Category = "System")
+		int32 GetNumPlayerEventsOfInterest(int32 vehicleIndex) const;
+
+	// Get an event of interest for a vehicle, 0 being the most recent, or a default event if none.
+	UFUNCTION(BlueprintCallable, Category = "System")
+		FGameEvent GetPlayerEventOfInterestByIndex(int32 vehicleIndex, int32 index) const
+	{ const FGameEvent* gameEvent = GetPlayerEventOfInterest(vehicleIndex, index); return (gameEvent != nullptr) ? *gameEvent : FGameEvent(); }
 
 	// The vehicles currently present in the game.
 	UPROPERTY(Transient)
@@ -572,6 +838,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = UI)
 		FDifficultyCharacteristics& GetDifficultyCharacteristics(int32 level = -1);
 
+	// Get the difficulty characteristics for a given level, or the current level if -1 is passed.
+	const FDifficultyCharacteristics& GetDifficultyCharacteristics(int32 level = -1) const;
+
 	// Get the vehicle that is the current camera target.
 	ABaseVehicle* CameraTarget(int32 localPlayerIndex);
 
@@ -625,13 +894,29 @@ public:
 	// Project a point in world space for use on the HUD.
 	bool ProjectWorldLocationToWidgetPosition(APawn* pawn, FVector worldLocation, FVector2D& screenPosition, FMinimalViewInfo* cachedView = nullptr);
 
+	// Project a batch of points in world space for use on the HUD, returning the number that are on-screen.
+	int32 ProjectWorldLocationsToWidgetPositions(const FHUDProjectionContext& context, const FVector* worldLocations, int32 numLocations, FVector2D* screenPositions, FMathEx::OutCode* outCodes = nullptr) const;
+
+	// Get the projection context for a local player, building it if it's not current.
+	const FHUDProjectionContext& GetHUDProjectionContext(int32 localPlayerIndex);
+
+	// Get the index of the local player that controls a pawn, or -1 if none.
+	int32 GetLocalPlayerIndex(APawn* pawn) const;
+
 	// Are there no opponents left in this game?
 	bool NoOpponentsLeft() const
 	{ return ((Vehicles.Num() - NumPlayersDestroyed) < 2); }
 
 	// Record the destruction of a player for this game.
-	void DestroyPlayer(ABaseVehicle* vehicle)
-	{ NumPlayersDestroyed++; }
+	void DestroyPlayer(ABaseVehicle* vehicle);
+
+	// Publish a race event, to be dispatched to its subscribers at the end of the game mode tick.
+	void PublishRaceEvent(const FRaceEvent& raceEvent)
+	{ PendingRaceEvents.Emplace(raceEvent); }
+
+	// Get the delegate for subscribing to a type of race event.
+	FRaceEventDelegate& OnRaceEvent(ERaceEventType type)
+	{ return RaceEventDelegates[(int32)type]; }
 
 	// Get the time left before the game starts.
 	float GetPreStartTime() const;
@@ -682,6 +967,31 @@ public:
 	void RemoveAttractable(AActor* actor)
 	{ if (Attractables.Contains(actor) == true) { Attractables.Remove(actor); Attractables.Compact(); } }
 
+	// Get the snapshot of the race for the HUD, taken once per frame.
+	const FHUDRaceSnapshot& GetHUDRaceSnapshot() const
+	{ return HUDRaceSnapshot; }
+
+	// Get the statistics on the pack of vehicles for this frame.
+	const FPackStatistics& GetPackStatistics() const
+	{ return PackStatistics; }
+
+	// Get the aggression for one vehicle to use offensive weapons against another, from 0 timid to 1 aggressive.
+	float GetWeaponAggression(int32 attackerIndex, int32 targetIndex) const;
+
+	// Get the track frames for all vehicles, missiles and avoidables, in that order.
+	const TArray<FTrackFrame>& GetTrackFrames() const
+	{ return TrackFrames; }
+
+	// Get the track frame for a vehicle, from its index into the vehicle list.
+	const FTrackFrame* GetVehicleTrackFrame(int32 index) const
+	{ return (index < Vehicles.Num() && TrackFrames.IsValidIndex(index) == true) ? &TrackFrames[index] : nullptr; }
+
+	// Get the track frame for an actor, or nullptr if it doesn't have one.
+	const FTrackFrame* FindTrackFrame(const AActor* actor) const;
+
+	// Get the track cameras that currently have enough vehicles in their detection intervals to be used.
+	void GetTrackCameraCandidates(TArray<AStaticTrackCamera*>& candidates) const;
+
 	// Determine the vehicles that are currently present in the level.
 	void DetermineVehicles();
 
@@ -691,6 +1001,58 @@ public:
 	// Record an event that has just occurred within the game.
 	void AddGameEvent(FGameEvent& gameEvent);
 
+	// Get a retained game event, 0 being the oldest, or nullptr if none.
+	const FGameEvent* GetGameEvent(int32 index) const
+	{ return (index >= 0 && index < GetNumGameEvents()) ? &GameEvents[(NumGameEventsAdded - GetNumGameEvents() + index) % MaxGameEvents] : nullptr; }
+
+	// Get an event of interest for a vehicle, 0 being the most recent, or nullptr if none.
+	const FGameEvent* GetPlayerEventOfInterest(int32 vehicleIndex, int32 index) const;
+
+	// Acquire an actor of a class from its pool, spawning one if there isn't a pool for the class.
+	AActor* AcquirePooledActor(UClass* actorClass, const FTransform& transform, AActor* owner = nullptr, APawn* instigator = nullptr);
+
+	// Acquire an actor of a class from its pool.
+	template<typename T>
+	T* AcquirePooledActor(TSubclassOf<T> actorClass, const FTransform& transform, AActor* owner = nullptr, APawn* instigator = nullptr)
+	{ return Cast<T>(AcquirePooledActor(actorClass.Get(), transform, owner, instigator)); }
+
+	// Return an actor to its pool, destroying it if it doesn't have one.
+	void ReleasePooledActor(AActor* actor);
+
+	// Get the actor pools, for instrumentation.
+	const TMap<UClass*, FActorPool>& GetActorPools() const
+	{ return ActorPools; }
+
+	// Get the manager for the audio of all of the vehicles.
+	FVehicleAudioManager& GetVehicleAudioManager()
+	{ return VehicleAudioManager; }
+
+	// Add a homing missile to the game, to be simulated by the missile manager.
+	void AddMissile(AHomingMissile* missile, const FVector& velocity);
+
+	// Remove a homing missile from the game.
+	void RemoveMissile(AHomingMissile* missile);
+
+	// Get the manager for the simulation of all of the homing missiles.
+	const FMissileManager& GetMissileManager() const
+	{ return MissileManager; }
+
+	// Get the manager for the hit testing and impact effects of all of the gun rounds.
+	FGunRoundManager& GetGunRoundManager()
+	{ return GunRoundManager; }
+
+	// Intern a string for use in game events, returning its ID.
+	int32 InternGameEventString(const FString& text);
+
+	// Release a reference to an interned game event string, freeing it when none remain.
+	void ReleaseGameEventString(int32 id);
+
+	// The maximum number of game events retained.
+	static const int32 MaxGameEvents = 64;
+
+	// The maximum number of events of interest retained for each vehicle.
+	static const int32 MaxPlayerEventsOfInterest = 8;
+
 	// Convert a master racing spline distance to a lap distance.
 	float MasterRacingSplineDistanceToLapDistance(float distance);
 
@@ -762,6 +1124,33 @@ private:
 	// Upload the loading of the main UI.
 	void UpdateUILoading();
 
+	// Update the track frames for all of the vehicles, missiles and avoidables.
+	void UpdateTrackFrames();
+
+	// Build the index of the track camera detection intervals along the master racing spline.
+	void BuildTrackCameraIndex();
+
+	// Update the AI bot drivers, deciding in parallel from a snapshot of the world and then applying serially.
+	void UpdateAIDrivers();
+
+	// Take the snapshot of the world for the AI bot drivers to decide from.
+	void BuildAISnapshot();
+
+	// Take the snapshot of the race for the HUD.
+	void UpdateHUDRaceSnapshot();
+
+	// Compute the statistics on the pack of vehicles and the catch-up scalars for this frame.
+	void UpdatePackStatistics();
+
+	// Create and prewarm the actor pools for the pickups.
+	void PrewarmActorPools();
+
+	// Dispatch all of the race events published since the last dispatch.
+	void DispatchRaceEvents();
+
+	// Build a projection context from a view and the size of its viewport.
+	void BuildHUDProjectionContext(FHUDProjectionContext& context, const FMatrix& viewProjectionMatrix, const FVector& viewLocation, const FVector2D& viewportSize) const;
+
 	// Calculate the maximum number of players.
 	int32 CalculateMaxPlayers() const;
 
@@ -804,6 +1193,111 @@ private:
 	// This is used to help calculate the relative volume level of each of the vehicles effectively.
 	TArray<ABaseVehicle*> WatchedVehicles;
 
+	// The snapshot of the race for the HUD.
+	FHUDRaceSnapshot HUDRaceSnapshot;
+
+	// The statistics on the pack of vehicles for this frame.
+	FPackStatistics PackStatistics;
+
+	// The projection contexts for each of the local players.
+	FHUDProjectionContext HUDProjectionContexts[GRIP_MAX_LOCAL_PLAYERS];
+
+	// The ring of the most recent game events, indexed by sequence number modulo MaxGameEvents.
+	FGameEvent GameEvents[MaxGameEvents];
+
+	// The number of game events ever added, the sequence number of the next one.
+	uint32 NumGameEventsAdded = 0;
+
+	// The sequence numbers of the most recent events of interest for each vehicle, in rings of their own.
+	uint32 PlayerEventsOfInterest[GRIP_MAX_PLAYERS][MaxPlayerEventsOfInterest];
+
+	// The number of events of interest ever added for each vehicle.
+	uint32 NumPlayerEventsOfInterest[GRIP_MAX_PLAYERS] = { 0 };
+
+	// The interned strings for game events, indexed by ID.
+	TArray<FString> GameEventStrings;
+
+	// The number of events in the ring referencing each interned string, indexed by ID.
+	TArray<int32> GameEventStringReferences;
+
+	// The IDs of interned strings that have been freed, for reuse.
+	TArray<int32> FreeGameEventStringIDs;
+
+	// The IDs of the interned strings for game events.
+	TMap<FString, int32> GameEventStringIDs;
+
+#if GRIP_LOG_EVICTED_GAME_EVENTS
+	// The binary file that evicted game events are written to.
+	FArchive* GameEventLog = nullptr;
+#endif // GRIP_LOG_EVICTED_GAME_EVENTS
+
+	// The race events published and waiting to be dispatched.
+	TArray<FRaceEvent> PendingRaceEvents;
+
+	// The race events being dispatched, events published during dispatch wait for the next one.
+	TArray<FRaceEvent> DispatchingRaceEvents;
+
+	// The subscribers to each type of race event.
+	FRaceEventDelegate RaceEventDelegates[(int32)ERaceEventType::Num];
+
+	// The race position of each vehicle at the last dispatch, to detect changes in position.
+	TArray<int32> DispatchedRacePositions;
+
+	// The track frames for all of the vehicles, missiles and avoidables, calculated once per frame.
+	TArray<FTrackFrame> TrackFrames;
+
+	// The track frames from the last frame, used to seed the search for the current ones.
+	TArray<FTrackFrame> LastTrackFrames;
+
+	// The snapshot of the world for the AI bot drivers to decide from.
+	FAIWorldSnapshot AISnapshot;
+
+	// The vehicles whose AI bot drivers are deciding on this frame.
+	TArray<ABaseVehicle*> AIDeciders;
+
+	// The decisions made by the AI bot drivers on this frame, in the same order as AIDeciders.
+	TArray<FVehicleAIDecision> AIDecisions;
+
+	// The distance from the nearest human player beyond which AI bots decide at a reduced rate, in centimeters.
+	static const float AIReducedRateDistance;
+
+	// The number of frames between decisions for AI bots at the reduced rate.
+	static const int32 AIReducedRateFrames = 4;
+
+	// The lateral grip assumed when baking the speed profiles of the pursuit splines, in G.
+	static const float SpeedProfileLateralGrip;
+
+	// The acceleration assumed when baking the speed profiles of the pursuit splines, in G.
+	static const float SpeedProfileAcceleration;
+
+	// The braking assumed when baking the speed profiles of the pursuit splines, in G.
+	static const float SpeedProfileBraking;
+
+	// The top speed assumed when baking the speed profiles of the pursuit splines, in KPH.
+	static const float SpeedProfileMaximumSpeed;
+
+	// The track camera detection intervals, sorted by start distance.
+	TArray<FTrackCameraInterval> TrackCameraIntervals;
+
+	// The length of the longest track camera detection interval, in centimeters.
+	float MaxTrackCameraInterval = 0.0f;
+
+	// The actor pools for the pickups and their effects, keyed by class.
+	UPROPERTY(Transient)
+		TMap<UClass*, FActorPool> ActorPools;
+
+	// The manager for the audio of all of the vehicles.
+	UPROPERTY(Transient)
+		FVehicleAudioManager VehicleAudioManager;
+
+	// The manager for the simulation of all of the homing missiles.
+	UPROPERTY(Transient)
+		FMissileManager MissileManager;
+
+	// The manager for the hit testing and impact effects of all of the gun rounds.
+	UPROPERTY(Transient)
+		FGunRoundManager GunRoundManager;
+
 	// The pawn that is currently the focus of the camera cycling system.
 	UPROPERTY(Transient)
 		APawn* ViewingPawn = nullptr;
@@ -130,6 +130,17 @@ public:
 	UPROPERTY(EditAnywhere, Category = Gun)
 		USoundCue* BarrelSpinSoundNonPlayer = nullptr;
 
+	// The particle systems to use for round impacts, by the surface hit, started from a pool. Surfaces without one use the vehicle's impact characteristics.
+	UPROPERTY(EditAnywhere, Category = Gun)
+		TMap<EGameSurface, UParticleSystem*> ImpactEffects;
+
+	// Sound cue for round impacts, or nullptr to use the vehicle's impact characteristics.
+	UPROPERTY(EditAnywhere, Category = Gun)
+		USoundCue* ImpactSound = nullptr;
+
+	// Fire a round from the gun, queuing it for hit testing with the other rounds fired this frame.
+	bool FireRound(const FVector& start, const FVector& direction, bool charged);
+
 	// Perform some blueprint code when a bullet round hits a surface.
 	UFUNCTION(BlueprintImplementableEvent, Category = Gun)
 		void BulletHitAnimation(UPrimitiveComponent* component, const TArray<UParticleSystem*>& particleSystems, const TArray<FVector>& hitLocations, USoundCue* soundEffect, const FVector& location, const FRotator& rotation, EGameSurface surface, const FVector& colour, bool charged);
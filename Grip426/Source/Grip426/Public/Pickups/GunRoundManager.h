@@ -0,0 +1,145 @@
+/**
+*
+* Gun round manager.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Hit testing and impact effects for all of the rounds fired by Gatling guns in the
+* game. Rounds fired during a frame are queued and submitted together as async
+* traces, and their hits are resolved on the next frame into a small pool of
+* impact effects, with hits close together on the same surface merged into one.
+* The cost per frame is bounded however many guns are firing.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+#include "worldcollision.h"
+#include "effects/drivingsurfacecharacteristics.h"
+#include "gunroundmanager.generated.h"
+
+class AGatlingGun;
+
+/**
+* A round fired from a gun, waiting for its hit test.
+***********************************************************************************/
+
+struct FGunRound
+{
+public:
+
+	// The gun that fired the round.
+	TWeakObjectPtr<AGatlingGun> Gun;
+
+	// The start location of the round.
+	FVector Start = FVector::ZeroVector;
+
+	// The end location of the round, if it doesn't hit anything.
+	FVector End = FVector::ZeroVector;
+
+	// Is the round charged?
+	bool Charged = false;
+};
+
+/**
+* An impact of one or more rounds, merged together for a single effect.
+***********************************************************************************/
+
+struct FGunImpact
+{
+public:
+
+	// The gun that fired the first of the rounds.
+	TWeakObjectPtr<AGatlingGun> Gun;
+
+	// The component that was hit.
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+
+	// The surface that was hit.
+	EGameSurface Surface = EGameSurface::Default;
+
+	// The location of the first of the hits.
+	FVector Location = FVector::ZeroVector;
+
+	// The surface normal at the first of the hits.
+	FVector Normal = FVector::UpVector;
+
+	// Were any of the rounds charged?
+	bool Charged = false;
+
+	// The locations of all of the hits merged into this impact.
+	TArray<FVector> HitLocations;
+};
+
+/**
+* Manager for the hit testing and impact effects of all of the gun rounds in a game.
+***********************************************************************************/
+
+USTRUCT()
+struct FGunRoundManager
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// Queue a round for hit testing, returning false if the queue is full and the round was dropped.
+	bool QueueRound(AGatlingGun* gun, const FVector& start, const FVector& direction, bool charged);
+
+	// Resolve the hits from the last frame into impact effects and submit the rounds queued since.
+	void Tick(UWorld* world, AActor* owner);
+
+	// Remove all of the rounds and effects.
+	void Empty();
+
+	// The range of a round, in centimeters.
+	static const float RoundRange;
+
+	// The distance within which hits on the same surface are merged into one impact, in centimeters.
+	static const float MergeDistance;
+
+	// The maximum number of rounds submitted for hit testing in a frame.
+	static const int32 MaxRoundsPerFrame = 32;
+
+	// The maximum number of rounds waiting to be submitted, beyond which they're dropped.
+	static const int32 MaxQueuedRounds = 64;
+
+	// The maximum number of impact effects started in a frame.
+	static const int32 MaxImpactsPerFrame = 8;
+
+	// The maximum number of impact effect components in the pool.
+	static const int32 MaxPooledImpactEffects = 16;
+
+private:
+
+	// Merge a hit into this frame's impacts, starting a new impact if it's not near an existing one.
+	void MergeHit(const FGunRound& round, const FHitResult& hit, int32& numImpacts);
+
+	// Start the effect for an impact.
+	void StartImpactEffect(UWorld* world, AActor* owner, FGunImpact& impact);
+
+	// Get an impact effect component from the pool for a template.
+	UParticleSystemComponent* GetPooledImpactEffect(AActor* owner, UParticleSystem* emitterTemplate);
+
+	// The rounds waiting to be submitted for hit testing.
+	TArray<FGunRound> QueuedRounds;
+
+	// The rounds submitted for hit testing on the last frame.
+	TArray<FGunRound> SubmittedRounds;
+
+	// The trace handles for the submitted rounds.
+	TArray<FTraceHandle> SubmittedTraces;
+
+	// The impacts for this frame, kept between frames to reuse their allocations.
+	TArray<FGunImpact> Impacts;
+
+	// The impact effect components, each either playing or finished and free for reuse.
+	UPROPERTY(Transient)
+		TArray<UParticleSystemComponent*> ImpactEffects;
+
+	// The index of the impact effect component to steal next if they're all playing.
+	int32 NextSteal = 0;
+};
@@ -75,6 +75,9 @@ public:
 	// Construct a homing missile.
 	AHomingMissile();
 
+	// Reset the state of the missile as it's taken from an actor pool, ready for reuse.
+	virtual void ResetForPool() override;
+
 	// The amount of variance of the angle of ejection, for untargeted missiles.
 	UPROPERTY(EditAnywhere, Category = Missile, meta = (UIMin = "0", UIMax = "1", ClampMin = "0", ClampMax = "1"))
 		float AngleVariance = 0.1f;
@@ -163,5 +166,9 @@ public:
 	UPROPERTY(Transient)
 		UAudioComponent* RocketAudio = nullptr;
 
+	// Explode the missile, from a blocking hit, its proximity fuse or its rocket running out.
+	UFUNCTION(BlueprintNativeEvent, Category = Missile)
+		void Explode(const FHitResult& hit);
+
 	friend class ADebugMissileHUD;
 };
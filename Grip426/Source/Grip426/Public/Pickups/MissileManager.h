@@ -0,0 +1,134 @@
+/**
+*
+* Missile manager.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Advances all of the homing missiles in the game in a single pass, rather than
+* each missile having its own movement component do the work. The state for the
+* missiles is held as separate arrays, terrain following is from baked ground
+* offsets on missile assistance splines where available and batched asynchronous
+* traces elsewhere, and the closest threatening missile for each vehicle drops out
+* of the same pass.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+#include "worldcollision.h"
+#include "missilemanager.generated.h"
+
+class AHomingMissile;
+class UPursuitSplineComponent;
+
+/**
+* The closest threatening missile to a vehicle.
+***********************************************************************************/
+
+struct FMissileThreat
+{
+public:
+
+	// The missile, or nullptr if there is no threat.
+	AHomingMissile* Missile = nullptr;
+
+	// The distance from the missile to the vehicle, in centimeters.
+	float Distance = 0.0f;
+
+	// The time before the missile reaches the vehicle at their current closing speed, in seconds.
+	float TimeToImpact = 0.0f;
+
+	// The missile warning amount between 0 and 1, 1 being imminent.
+	float WarningAmount = 0.0f;
+};
+
+/**
+* Manager for simulating all of the homing missiles in a game.
+***********************************************************************************/
+
+USTRUCT()
+struct FMissileManager
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// Add a missile to be simulated, taking over from its own movement component.
+	void AddMissile(AHomingMissile* missile, const FVector& velocity);
+
+	// Remove a missile from being simulated.
+	void RemoveMissile(AHomingMissile* missile);
+
+	// Add a missile assistance spline to take baked ground offsets from.
+	void AddAssistanceSpline(UPursuitSplineComponent* spline);
+
+	// Advance all of the missiles and determine the closest threat to each vehicle.
+	void Tick(UWorld* world, float deltaSeconds);
+
+	// Get the closest threatening missile to a vehicle.
+	FMissileThreat GetThreat(int32 vehicleIndex) const
+	{ return (vehicleIndex >= 0 && vehicleIndex < GRIP_MAX_PLAYERS) ? Threats[vehicleIndex] : FMissileThreat(); }
+
+	// Get the number of missiles being simulated.
+	int32 Num() const
+	{ return Missiles.Num(); }
+
+	// Remove all of the missiles and splines.
+	void Empty();
+
+	// The clearance missiles try to keep from the ground, in centimeters.
+	static const float TerrainClearance;
+
+	// The length of the probe used to find the ground when there's no baked ground offset, in centimeters.
+	static const float TerrainProbeLength;
+
+	// The distance from a missile assistance spline within which its baked ground offsets are used, in centimeters.
+	static const float AssistanceSplineRange;
+
+	// The time to impact below which the missile warning starts to rise, in seconds.
+	static const float WarningTime;
+
+private:
+
+	// Consume the terrain traces that were issued on the last frame.
+	void ConsumeTerrainTraces(UWorld* world);
+
+	// Get the baked ground offset for a missile from the nearest missile assistance spline, returning false if there isn't one.
+	bool GetBakedGroundOffset(int32 index, FVector& groundOffset);
+
+	// The missiles being simulated.
+	UPROPERTY(Transient)
+		TArray<AHomingMissile*> Missiles;
+
+	// The missile assistance splines to take baked ground offsets from.
+	UPROPERTY(Transient)
+		TArray<UPursuitSplineComponent*> AssistanceSplines;
+
+	// The location of each missile.
+	TArray<FVector> Locations;
+
+	// The velocity of each missile, in centimeters per second.
+	TArray<FVector> Velocities;
+
+	// The time each missile has been flying for, in seconds.
+	TArray<float> Ages;
+
+	// The offset from each missile to the ground, or zero if none was found.
+	TArray<FVector> GroundOffsets;
+
+	// The terrain trace in flight for each missile.
+	TArray<FTraceHandle> TerrainTraces;
+
+	// The index of the missile assistance spline each missile was last near, or INDEX_NONE.
+	TArray<int32> AssistanceSplineIndices;
+
+	// The distance along the missile assistance spline each missile was last at, used as a search hint.
+	TArray<float> AssistanceSplineDistances;
+
+	// The closest threatening missile for each vehicle, indexed by vehicle index.
+	FMissileThreat Threats[GRIP_MAX_PLAYERS];
+};
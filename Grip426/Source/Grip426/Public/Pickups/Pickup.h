@@ -179,6 +179,14 @@ public:
 	virtual float GetAttractionAngleRange() const override
 	{ return AttractionAngleRange; }
 
+	// Get the surface probe currently in flight.
+	virtual FSurfaceProbe& GetSurfaceProbe() override
+	{ return SurfaceProbe; }
+
+	// Get the surface probe currently in flight.
+	virtual const FSurfaceProbe& GetSurfaceProbe() const override
+	{ return SurfaceProbe; }
+
 	enum class EState : uint8
 	{
 		Uncollected,
@@ -200,6 +208,9 @@ private:
 	// The range of attraction, in centimeters.
 	float AttractionDistanceRangeCms = 0.0f;
 
+	// The surface probe currently in flight, for positioning the pickup at run-time.
+	FSurfaceProbe SurfaceProbe;
+
 	// Audio component for the collected sound.
 	UPROPERTY(Transient)
 		UAudioComponent* CollectedAudio = nullptr;
@@ -55,6 +55,15 @@ public:
 	bool LaunchVehicleIsValid() const
 	{ return (LaunchVehicle != nullptr); }
 
+	// Reset the state of the pickup as it's taken from an actor pool, ready for reuse.
+	virtual void ResetForPool();
+
+	// Activate the pickup as it's taken from an actor pool.
+	virtual void ActivateFromPool();
+
+	// Deactivate the pickup as it's returned to an actor pool.
+	virtual void DeactivateToPool();
+
 protected:
 
 	// Naked pointer to game state for performance reasons.
@@ -71,4 +80,8 @@ protected:
 	// The launch vehicle for this pickup.
 	UPROPERTY(Transient)
 		ABaseVehicle* LaunchVehicle = nullptr;
+
+	// The components that were ticking when the pickup was returned to its actor pool.
+	UPROPERTY(Transient)
+		TArray<UActorComponent*> PooledTickingComponents;
 };
@@ -0,0 +1,92 @@
+/**
+*
+* Actor pools.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Pools of actors of a single class, spawned up front and then activated and
+* deactivated as they're needed rather than being spawned and destroyed each time,
+* which causes hitches for actors with lots of components like the pickups.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+#include "actorpool.generated.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(GripLogActorPools, Log, All);
+
+/**
+* A pool of actors of a single class.
+***********************************************************************************/
+
+USTRUCT()
+struct FActorPool
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	FActorPool() = default;
+
+	FActorPool(UClass* actorClass, int32 capacity)
+		: ActorClass(actorClass)
+		, Capacity(capacity)
+	{ }
+
+	// Spawn actors until the pool holds its capacity.
+	void Prewarm(UWorld* world);
+
+	// Acquire an actor from the pool at a transform, spawning a new one if the pool is exhausted.
+	AActor* Acquire(UWorld* world, const FTransform& transform, AActor* owner, APawn* instigator);
+
+	// Return an actor to the pool.
+	void Release(AActor* actor);
+
+	// Empty the pool, destroying all of the actors that are free.
+	void Empty();
+
+	// Log the instrumentation for the pool.
+	void LogStatistics() const;
+
+	// The class of the actors in the pool.
+	UPROPERTY(Transient)
+		UClass* ActorClass = nullptr;
+
+	// The actors that are free for use.
+	UPROPERTY(Transient)
+		TArray<AActor*> FreeActors;
+
+	// The number of actors the pool is expected to need at most.
+	int32 Capacity = 0;
+
+	// The number of actors that have been spawned for the pool.
+	int32 NumSpawned = 0;
+
+	// The number of actors currently in use.
+	int32 NumInUse = 0;
+
+	// The highest number of actors that have been in use at once.
+	int32 PeakInUse = 0;
+
+	// The number of times an actor has been acquired from the pool.
+	int32 NumAcquired = 0;
+
+	// The number of times the pool has had to spawn beyond its capacity.
+	int32 NumOverflows = 0;
+
+private:
+
+	// Spawn a new actor for the pool, deactivated.
+	AActor* Spawn(UWorld* world);
+
+	// Activate an actor as it's taken from the pool.
+	static void Activate(AActor* actor);
+
+	// Deactivate an actor as it's returned to the pool.
+	static void Deactivate(AActor* actor);
+};
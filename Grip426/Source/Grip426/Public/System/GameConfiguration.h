@@ -77,6 +77,7 @@ DECLARE_LOG_CATEGORY_EXTERN(GripTeleportationLog, Log, All);
 #define GRIP_BOT_INTELLIGENT_SPEEDVSGRIP 1						// Have bots use intelligent optimum speed calculation based on their cornering grip
 
 #define GRIP_FIXED_TIMING 0										// Use fixed rather than dynamic engine timing, usually used for physics testing
+#define GRIP_LOG_EVICTED_GAME_EVENTS 0							// Write game events to a binary file in the Saved folder as they're evicted from the game event ring
 
 #if GRIP_FIXED_TIMING
 #define GRIP_TIMING_FPS 60.0f									// If fixed timing, then how many frames per second
@@ -112,9 +112,11 @@ namespace FMathEx
 	*
 	* Returns a number between 0 and 1 for a valid target, with 0 being perfect weight.
 	* Returns -1 for an invalid target.
+	*
+	* maxDegrees is the acos of maxCosAngle, if the caller already has it to hand.
 	***********************************************************************************/
 
-	inline float TargetWeight(const FVector& fromPosition, const FVector& fromDirection, const FVector& targetPosition, float minDistance, float maxDistance, float maxCosAngle, bool weightAngle)
+	inline float TargetWeight(const FVector& fromPosition, const FVector& fromDirection, const FVector& targetPosition, float minDistance, float maxDistance, float maxCosAngle, bool weightAngle, float maxDegrees = -1.0f)
 	{
 		FVector targetDirection = targetPosition - fromPosition;
 		float distance = targetDirection.Size();
@@ -132,8 +134,12 @@ namespace FMathEx
 
 			if (dotProduct > maxCosAngle)
 			{
+				if (maxDegrees < 0.0f)
+				{
+					maxDegrees = FMath::Acos(maxCosAngle);
+				}
+
 				float degrees = FMath::Acos(dotProduct);
-				float maxDegrees = FMath::Acos(maxCosAngle);
 				float distanceFactor = (distance - minDistance) / (maxDistance - minDistance);
 
 				// Cube the distance to prefer closer targets rather than less angle away.
@@ -145,6 +151,62 @@ namespace FMathEx
 		return -1.0f;
 	}
 
+	/**
+	* Weight a batch of targets, given as separate arrays of X, Y and Z, writing the
+	* same weights to weights as TargetWeight would for each.
+	*
+	* The range and cone tests are done four targets at a time as a conservative reject,
+	* widened slightly so that they never reject a target that TargetWeight would
+	* accept. Only the targets that survive are weighted, by TargetWeight itself and
+	* sharing the acos of the cone angle, so every weight, and therefore every ranking,
+	* is exactly what TargetWeight gives. Most targets are out of range or outside the
+	* cone, so most never reach the scalar path.
+	***********************************************************************************/
+
+	inline void TargetWeights(const FVector& fromPosition, const FVector& fromDirection, const float* targetX, const float* targetY, const float* targetZ, int32 numTargets, float minDistance, float maxDistance, float maxCosAngle, bool weightAngle, float* weights)
+	{
+		const float tolerance = 1.0e-3f;
+		float maxDegrees = FMath::Acos(maxCosAngle);
+		VectorRegister fromX = VectorSetFloat1(fromPosition.X);
+		VectorRegister fromY = VectorSetFloat1(fromPosition.Y);
+		VectorRegister fromZ = VectorSetFloat1(fromPosition.Z);
+		VectorRegister directionX = VectorSetFloat1(fromDirection.X);
+		VectorRegister directionY = VectorSetFloat1(fromDirection.Y);
+		VectorRegister directionZ = VectorSetFloat1(fromDirection.Z);
+		VectorRegister minDistanceSquared = VectorSetFloat1((minDistance > 0.0f) ? FMath::Square(minDistance) * (1.0f - tolerance) : -1.0f);
+		VectorRegister maxDistanceSquared = VectorSetFloat1(FMath::Square(maxDistance) * (1.0f + tolerance));
+		VectorRegister coneCos = VectorSetFloat1(maxCosAngle - tolerance);
+		VectorRegister smallNumber = VectorSetFloat1(SMALL_NUMBER);
+		int32 i = 0;
+
+		for (; i + 4 <= numTargets; i += 4)
+		{
+			VectorRegister x = VectorSubtract(VectorLoad(targetX + i), fromX);
+			VectorRegister y = VectorSubtract(VectorLoad(targetY + i), fromY);
+			VectorRegister z = VectorSubtract(VectorLoad(targetZ + i), fromZ);
+			VectorRegister distanceSquared = VectorMultiplyAdd(x, x, VectorMultiplyAdd(y, y, VectorMultiply(z, z)));
+			VectorRegister distance = VectorMultiply(distanceSquared, VectorReciprocalSqrtAccurate(VectorMax(distanceSquared, smallNumber)));
+			VectorRegister dotProduct = VectorMultiplyAdd(x, directionX, VectorMultiplyAdd(y, directionY, VectorMultiply(z, directionZ)));
+
+			// Comparing the unnormalized dot product against the cone scaled by the
+			// distance is the same as comparing the normalized one against the cone.
+
+			VectorRegister inRange = VectorBitwiseAnd(VectorCompareGT(distanceSquared, minDistanceSquared), VectorCompareGT(maxDistanceSquared, distanceSquared));
+			VectorRegister inCone = VectorCompareGT(dotProduct, VectorMultiply(coneCos, distance));
+			int32 survivors = VectorMaskBits(VectorBitwiseAnd(inRange, inCone));
+
+			for (int32 j = 0; j < 4; j++)
+			{
+				weights[i + j] = ((survivors & (1 << j)) != 0) ? TargetWeight(fromPosition, fromDirection, FVector(targetX[i + j], targetY[i + j], targetZ[i + j]), minDistance, maxDistance, maxCosAngle, weightAngle, maxDegrees) : -1.0f;
+			}
+		}
+
+		for (; i < numTargets; i++)
+		{
+			weights[i] = TargetWeight(fromPosition, fromDirection, FVector(targetX[i], targetY[i], targetZ[i]), minDistance, maxDistance, maxCosAngle, weightAngle, maxDegrees);
+		}
+	}
+
 	/**
 	* Return unnormalized angle x to the range 0 to +PI * 2 radians.
 	***********************************************************************************/
@@ -1012,6 +1074,7 @@ namespace FMathEx
 	const OutCode OutCodeRight = 2;
 	const OutCode OutCodeBottom = 4;
 	const OutCode OutCodeTop = 8;
+	const OutCode OutCodeBehind = 16;
 
 	struct FRectangle
 	{
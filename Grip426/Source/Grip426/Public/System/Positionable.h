@@ -14,6 +14,7 @@
 #pragma once
 
 #include "system/gameconfiguration.h"
+#include "worldcollision.h"
 #include "Positionable.generated.h"
 
 /**
@@ -26,6 +27,53 @@ class UPositionableInterface : public UInterface
 	GENERATED_UINTERFACE_BODY()
 };
 
+/**
+* A surface probe in flight, issued as batches of asynchronous traces and refined
+* from coarse to fine over a couple of frames.
+***********************************************************************************/
+
+struct FSurfaceProbe
+{
+public:
+
+	enum class EStage : uint8
+	{
+		Idle,
+		Coarse,
+		Fine
+	};
+
+	// The stage the probe is currently at.
+	EStage Stage = EStage::Idle;
+
+	// The generation of the probe, so that traces from superseded probes can be ignored.
+	uint32 Generation = 0;
+
+	// The number of traces still to be returned for the current stage.
+	int32 NumPending = 0;
+
+	// The position the probe is searching from.
+	FVector Position = FVector::ZeroVector;
+
+	// The rotation the probe started with.
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	// The radius the probe is searching within.
+	float Radius = 0.0f;
+
+	// The collision channel to trace against.
+	ECollisionChannel Channel = ECC_MAX;
+
+	// The actor that owns the probe, ignored by the traces.
+	TWeakObjectPtr<AActor> Parent;
+
+	// The nearest hit found so far.
+	FHitResult MinHit;
+
+	// The squared distance to the nearest hit found so far.
+	float MinDistance = BIG_NUMBER;
+};
+
 /**
 * Interface class for the PositionableInterface.
 ***********************************************************************************/
@@ -38,4 +86,50 @@ public:
 
 	// Determine the surface position / rotation for an actor.
 	virtual bool DetermineSurfacePosition(FVector& position, FRotator& rotation, float radius, AActor* parent, ECollisionChannel channel = ECC_MAX, bool useRotation = false);
+
+	// Request the surface position / rotation for an actor, which is returned in OnSurfacePositionDetermined on a later frame.
+	bool RequestSurfacePosition(const FVector& position, const FRotator& rotation, float radius, AActor* parent, ECollisionChannel channel = ECC_MAX);
+
+	// Is a surface position request currently in flight?
+	bool IsSurfacePositionPending() const
+	{ return (GetSurfaceProbe().Stage != FSurfaceProbe::EStage::Idle); }
+
+	// Cancel any surface position request currently in flight.
+	void CancelSurfacePosition()
+	{ FSurfaceProbe& probe = GetSurfaceProbe(); probe.Stage = FSurfaceProbe::EStage::Idle; probe.Generation++; }
+
+	// Get the surface probe currently in flight, held by the implementing class.
+	virtual FSurfaceProbe& GetSurfaceProbe() = 0;
+
+	// Get the surface probe currently in flight, held by the implementing class.
+	virtual const FSurfaceProbe& GetSurfaceProbe() const = 0;
+
+protected:
+
+	// Handle the result of a surface position request.
+	virtual void OnSurfacePositionDetermined(bool found, const FVector& position, const FRotator& rotation)
+	{ }
+
+private:
+
+	// Issue an asynchronous trace for the current surface probe.
+	void IssueSurfaceTrace(UWorld* world, const FVector& start, const FVector& end, const FCollisionQueryParams& queryParams);
+
+	// Handle the return of an asynchronous trace for the current surface probe.
+	void OnSurfaceTrace(FTraceDatum& datum);
+
+	// Advance the current surface probe to its next stage once all of its traces have returned.
+	void AdvanceSurfaceProbe();
+
+	// Get the position / rotation for an actor from a surface hit.
+	static void ApplySurfaceHit(const FHitResult& hit, FVector& position, FRotator& rotation);
+
+	// The number of ray directions in the coarse stage of a surface probe, each traced outward along it and its opposite.
+	static const int32 NumCoarseRays = 7;
+
+	// The number of rays in the fine stage of a surface probe.
+	static const int32 NumFineRays = 8;
+
+	// The directions of the rays in the coarse stage of a surface probe.
+	static const FVector CoarseDirections[NumCoarseRays];
 };
@@ -21,6 +21,40 @@
 
 class USlateBrushAsset;
 class UCanvasPanel;
+class UBorder;
+class UTextBlock;
+struct FGameEvent;
+
+/**
+* A piece of text cached against the value it was built from, so that the text is
+* only formatted again when that value changes.
+***********************************************************************************/
+
+template<typename T>
+struct TCachedText
+{
+public:
+
+	// Get the text for a value, building it only if the value has changed.
+	template<typename F>
+	const FText& Get(const T& value, F build)
+	{ if (Valid == false || (Value == value) == false) { Value = value; Text = build(); Valid = true; } return Text; }
+
+	// Invalidate the text so that it's rebuilt next time.
+	void Invalidate()
+	{ Valid = false; }
+
+private:
+
+	// The value the text was built from.
+	T Value = T();
+
+	// The text built from the value.
+	FText Text;
+
+	// Is the text valid for the value?
+	bool Valid = false;
+};
 
 /**
 * A structure describing ignition properties for initializing a player HUD.
@@ -49,6 +83,14 @@ public:
 	// The widget to be ignited.
 	UPROPERTY(Transient)
 		UUserWidget* Widget = nullptr;
+
+	// The borders within the widget whose opacity is driven by the ignition.
+	UPROPERTY(Transient)
+		TArray<UBorder*> Borders;
+
+	// The text blocks within the widget whose opacity is driven by the ignition.
+	UPROPERTY(Transient)
+		TArray<UTextBlock*> TextBlocks;
 };
 
 /**
@@ -148,18 +190,15 @@ public:
 
 	// Get the speedo text.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetSpeedoText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("000") : FText::FromString(vehicle->GetFormattedSpeedKPH(0))); }
+		FText GetSpeedoText() const;
 
 	// Get the speedo text for the first portion of the rendering.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetSpeedoText1() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("000") : FText::FromString(vehicle->GetFormattedSpeedKPH(0))); }
+		FText GetSpeedoText1() const;
 
 	// Get the speedo text for the second portion of the rendering.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetSpeedoText2() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("000") : FText::FromString(vehicle->GetFormattedSpeedKPH(1))); }
+		FText GetSpeedoText2() const;
 
 	// Get the speed measurement text.
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -167,53 +206,43 @@ public:
 
 	// Get the left text for the player position.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetPositionTextLeft() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr || (vehicle->GetRaceState().LapNumber < 0 && GameState->GamePlaySetup.DrivingMode != EDrivingMode::Elimination)) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), ((GameState->IsGameModeRanked() == true) ? vehicle->GetRaceState().RaceRank + 1 : vehicle->GetRaceState().RacePosition + 1)))); }
+		FText GetPositionTextLeft() const;
 
 	// Get the right text for the player position.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetPositionTextRight() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("/%d"), PlayGameMode->GetNumOpponentsLeft()))); }
+		FText GetPositionTextRight() const;
 
 	// Get the left text for the player rank.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetRankTextLeft() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), vehicle->GetRaceState().RaceRank + 1))); }
+		FText GetRankTextLeft() const;
 
 	// Get the left text for the player lap.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetLapTextLeft() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr || vehicle->GetRaceState().LapNumber < 0) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), vehicle->GetRaceState().LapNumber + 1))); }
+		FText GetLapTextLeft() const;
 
 	// Get the right text for the player lap.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetLapTextRight() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("/%d"), (int32)GameState->GeneralOptions.NumberOfLaps))); }
+		FText GetLapTextRight() const;
 
 	// Get the text for the player points.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetPointsText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), vehicle->GetRaceState().NumInGamePoints))); }
+		FText GetPointsText() const;
 
 	// Get the text for the player kills.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetKillsText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d"), (int32)vehicle->GetRaceState().NumKills))); }
+		FText GetKillsText() const;
 
 	// Get the text for the player deaths.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetDeathsText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("/%d"), (int32)vehicle->GetRaceState().NumDeaths))); }
+		FText GetDeathsText() const;
 
 	// Get the text for the player damage.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetDamageText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(FString::Printf(TEXT("%d%%"), (int32)((float)(vehicle->GetRaceState().MaxHitPoints - vehicle->GetRaceState().HitPoints) / (float)vehicle->GetRaceState().MaxHitPoints * 100)))); }
+		FText GetDamageText() const;
 
 	// Get the text for the elimination timer.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetEliminationTimerText() const
-	{ return (PlayGameMode->GetEliminationTimer() >= 0.0f) ? FText::FromString(FString::Printf(TEXT("%02d"), FMath::CeilToInt(GRIP_ELIMINATION_SECONDS - PlayGameMode->GetEliminationTimer()))) : FText::FromString("--"); }
+		FText GetEliminationTimerText() const;
 
 	// Get the text for the elimination percentage.
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -232,8 +261,7 @@ public:
 
 	// Get the race time of the vehicle.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		FText GetRaceTimeText() const
-	{ ABaseVehicle* vehicle = GetTargetVehicle(); return ((vehicle == nullptr) ? FText::FromString("") : FText::FromString(vehicle->GetFormattedRaceTime())); }
+		FText GetRaceTimeText() const;
 
 	// Get the number of seconds left in a race
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -439,12 +467,12 @@ public:
 	// Get the text for the leading players distance ahead of the player.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetRacePositionScaleForeText() const
-	{ return GetRacePositionScaleText(GetRacePositionScale()); }
+	{ int32 distance = GetRacePositionScale(); return RacePositionScaleForeText.Get(distance, [distance] () { return FormatRacePositionScaleText(distance); }); }
 
 	// Get the text for the trailing players distance behind the player.
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		FText GetRacePositionScaleRearText() const
-	{ return GetRacePositionScaleText(-GetRacePositionScale()); }
+	{ int32 distance = -GetRacePositionScale(); return RacePositionScaleRearText.Get(distance, [distance] () { return FormatRacePositionScaleText(distance); }); }
 
 	// Get the text describing a race distance.
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -454,9 +482,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = HUD)
 		int32 GetRacePositionScale() const;
 
-	// Get all of the race positions for all of the players.
+	// Get all of the race positions for all of the players, copied out for Blueprint.
 	UFUNCTION(BlueprintCallable, Category = HUD)
-		TArray<FHUDRacePosition> GetRacePositions(float centre, float length) const;
+		TArray<FHUDRacePosition> GetRacePositions(float centre, float length) const
+	{ return UpdateRacePositions(centre, length); }
+
+	// Get the number of race positions, bringing them up to date for a layout.
+	UFUNCTION(BlueprintPure, Category = HUD)
+		int32 GetNumRacePositions(float centre, float length) const
+	{ return UpdateRacePositions(centre, length).Num(); }
+
+	// Get one of the race positions last brought up to date by GetNumRacePositions.
+	UFUNCTION(BlueprintPure, Category = HUD)
+		FHUDRacePosition GetRacePosition(int32 index) const
+	{ return (RacePositions.IsValidIndex(index) == true) ? RacePositions[index] : FHUDRacePosition(); }
 
 	// Get the angle of the ground from the perspective of the camera.
 	UFUNCTION(BlueprintCallable, Category = HUD)
@@ -502,8 +541,14 @@ protected:
 	float GetPanelOpacity(FHUDPanelIgnition& panel)
 	{ if (panel.Timer < panel.StartTime) return 0.15f; else return 1.0f; }
 
-	// Refresh all of the widgets that can be ignited for a particular panel.
-	void RefreshIgnitionWidgets(FHUDPanelIgnition& ignition, UPanelWidget* mainPanel);
+	// Refresh the opacity of all of the widgets resolved for a particular ignition.
+	void RefreshIgnitionWidgets(FHUDPanelIgnition& ignition);
+
+	// Resolve all of the widgets within a panel whose opacity is driven by an ignition.
+	static void ResolveIgnitionWidgets(FHUDPanelIgnition& ignition, UPanelWidget* mainPanel);
+
+	// Format the text describing a race distance.
+	static FText FormatRacePositionScaleText(int32 distance);
 
 	// Draw a vehicle diagnostics chart.
 	static void DrawVehicleDiagnosticsChart(UPARAM(ref) FPaintContext& context, USlateBrushAsset* brush, const ABaseVehicle* vehicle, float x, float y, float width, float height, const FTimedFloatList& list, float scale, bool angles, bool calculateDifference, const FString& title);
@@ -519,6 +564,59 @@ private:
 
 	// The widgets in this panel that require ignition.
 	TArray<FHUDPanelIgnition> IgnitionWidgets;
+
+	// Get the speedo text for a portion of the rendering, from its cache.
+	FText GetSpeedoText(int32 index, TCachedText<FIntPoint>& cache) const;
+
+	// Get the text for a number, or empty text for BlankNumber, from its cache.
+	static FText GetNumberText(int32 number, const TCHAR* format, TCachedText<int32>& cache);
+
+	// The number keyed for bindings that show no text.
+	static const int32 BlankNumber = MIN_int32;
+
+	// Bring the race positions for all of the players up to date for a layout.
+	const TArray<FHUDRacePosition>& UpdateRacePositions(float centre, float length) const;
+
+	// Get a weapon event for the HUD, 0 being the most recent, or nullptr if none.
+	const FGameEvent* GetWeaponEvent(int32 index) const;
+
+	// The number of weapon events we cache the text for.
+	static const int32 NumCachedWeaponEvents = 8;
+
+	// Cached texts for the text bindings, keyed on the values they're built from.
+	mutable TCachedText<FIntPoint> SpeedoText;
+	mutable TCachedText<FIntPoint> SpeedoText1;
+	mutable TCachedText<FIntPoint> SpeedoText2;
+	mutable TCachedText<int32> PositionTextLeft;
+	mutable TCachedText<int32> PositionTextRight;
+	mutable TCachedText<int32> RankTextLeft;
+	mutable TCachedText<int32> LapTextLeft;
+	mutable TCachedText<int32> LapTextRight;
+	mutable TCachedText<int32> PointsText;
+	mutable TCachedText<int32> KillsText;
+	mutable TCachedText<int32> DeathsText;
+	mutable TCachedText<int32> DamageText;
+	mutable TCachedText<int32> EliminationTimerText;
+	mutable TCachedText<float> RaceTimeText;
+	mutable TCachedText<int32> OutroPlacementText;
+	mutable TCachedText<int32> RacePositionScaleText;
+	mutable TCachedText<int32> RacePositionScaleForeText;
+	mutable TCachedText<int32> RacePositionScaleRearText;
+
+	// Cached texts for the weapon events, keyed on the event time and vehicle index.
+	mutable TCachedText<TPair<float, int32>> WeaponEventLeftTexts[NumCachedWeaponEvents];
+	mutable TCachedText<TPair<float, int32>> WeaponEventRightTexts[NumCachedWeaponEvents];
+
+	// The race positions last brought up to date, reused between frames.
+	mutable TArray<FHUDRacePosition> RacePositions;
+
+	// The HUD race snapshot frame that RacePositions was built from.
+	mutable int32 RacePositionsFrameNumber = -1;
+
+	// The vehicle index, centre and length that RacePositions was built for.
+	mutable int32 RacePositionsVehicleIndex = -1;
+	mutable float RacePositionsCentre = 0.0f;
+	mutable float RacePositionsLength = 0.0f;
 };
 
 /**
@@ -569,22 +667,42 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = HUD)
 		void LapCompleted(bool startFinalLap);
 
-	// Tick the HUD widget.
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
-
 	// Ignite the HUD and have the elements flicker on over time.
 	void Ignite();
 
+	// Invalidate the cached set of components, to be called if the widget hierarchy changes.
+	void InvalidateComponents() const
+	{ ComponentsPanel = nullptr; }
+
+protected:
+
+	// Destruct the HUD widget.
+	virtual void NativeDestruct() override;
+
 private:
 
+	// Handle a lap being completed by any vehicle.
+	void OnLapCompleted(const FRaceEvent& raceEvent);
+
+	// Get the components of the HUD widget that use ignition, resolving them if the hierarchy has changed.
+	const TArray<UHUDWidgetComponent*>& GetIgnitionComponents() const;
+
+	// The components of the HUD widget that use ignition.
+	// Naked pointers for speed, they're held in the widget tree for the lifetime of this widget.
+	mutable TArray<UHUDWidgetComponent*> IgnitionComponents;
+
+	// The panel that IgnitionComponents was resolved from, and its number of children at the time.
+	mutable UPanelWidget* ComponentsPanel = nullptr;
+	mutable int32 ComponentsPanelNumChildren = 0;
+
 	// The draw size of the widget.
 	FVector2D Size = FVector2D::ZeroVector;
 
 	// Has this HUD been ignited?
 	bool Ignited = false;
 
-	// The last lap that was signaled as completed.
-	int32 LastLapCompleted = 0;
+	// The handle for the subscription to lap completed events.
+	FDelegateHandle LapCompletedHandle;
 };
 
 /**
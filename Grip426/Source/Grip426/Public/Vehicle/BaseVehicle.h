@@ -419,6 +419,25 @@ public:
 
 #pragma endregion VehicleDamage
 
+/**
+* A pool of particle system components for a single template, attached to a vehicle.
+***********************************************************************************/
+
+USTRUCT()
+struct FParticleSystemPool
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// The components in the pool, each either playing or finished and free for reuse.
+	UPROPERTY(Transient)
+		TArray<UParticleSystemComponent*> Components;
+
+	// The world time at which each of the components was last started.
+	TArray<float> StartTimes;
+};
+
 /**
 * A small actor class for configuring and attaching canards to antigravity vehicles.
 ***********************************************************************************/
@@ -1020,6 +1039,9 @@ public:
 	// Get the speed of the vehicle, in kilometers / miles per hour.
 	FString GetFormattedSpeedKPH(int32 index) const;
 
+	// Get the speed of the vehicle as shown on the speedometer, and the number of digits to show it with.
+	int32 GetDisplayedSpeed(int32 index, int32& numDigits) const;
+
 	// Get the race time of the vehicle.
 	FString GetFormattedRaceTime() const
 	{ return GetFormattedTime(RaceState.RaceTime); }
@@ -1077,9 +1099,20 @@ public:
 	// Play a 1D client sound.
 	void ClientPlaySound(USoundBase* Sound, float VolumeMultiplier = 1.f, float PitchMultiplier = 1.f) const;
 
+	// Play a one-shot sound attached to the vehicle, within the voice budget for all of the vehicles.
+	UFUNCTION(BlueprintCallable, Category = Audio)
+		UAudioComponent* PlayAttachedSound(USoundBase* sound, float volume = 1.0f, float pitch = 1.0f);
+
 	// Play the denied sound when a player tries to do something that they cannot.
 	void PlayDeniedSound();
 
+	// Virtualize the engine audio, stopping it while the vehicle can't be heard and restarting it when it can.
+	void SetEngineAudioVirtualized(bool virtualized);
+
+	// Is the engine audio currently virtualized?
+	bool IsEngineAudioVirtualized() const
+	{ return EngineAudioVirtualized; }
+
 	// Shake the HUD, following an explosion or something.
 	void ShakeHUD(float strength);
 
@@ -1210,7 +1243,7 @@ public:
 
 	// Spawn an appropriately scaled particle system on the vehicle.
 	UFUNCTION(BlueprintCallable, Category = System)
-		UParticleSystemComponent* SpawnParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale = 1.0f, bool autoDestroy = true);
+		UParticleSystemComponent* SpawnParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale = 1.0f, bool autoDestroy = true, bool canReject = false);
 
 	// Is the vehicle current using cockpit-camera view?
 	UFUNCTION(BlueprintCallable, Category = "General")
@@ -1250,6 +1283,12 @@ public:
 	FVehicleAI& GetAI()
 	{ return AI; }
 
+	// Make the AI decisions for this frame from a snapshot of the world, safe to call on any thread.
+	void DecideAI(const FAIWorldSnapshot& snapshot, FVehicleAIDecision& decision) const;
+
+	// Apply the AI decisions made for this frame, on the game thread.
+	void ApplyAIDecision(const FVehicleAIDecision& decision);
+
 	// Are all of the pickup slots filled?
 	bool ArePickupSlotsFilled() const
 	{ return false; }
@@ -1434,6 +1473,27 @@ private:
 	// Have pickup probabilities been initialized for this game mode?
 	static bool ProbabilitiesInitialized;
 
+	// Get a particle system component from the pool for a template.
+	UParticleSystemComponent* GetPooledParticleSystem(UParticleSystem* emitterTemplate);
+
+	// Should a rejectable particle system be spawned on this vehicle this frame?
+	bool ShouldSpawnPooledParticleSystem() const;
+
+	// The maximum number of particle system components pooled for each template on each vehicle.
+	static const int32 MaxPooledParticleSystems = 4;
+
+	// The maximum number of rejectable particle systems spawned on each vehicle in a frame.
+	static const int32 MaxParticleSystemSpawnsPerFrame = 2;
+
+	// The distance from the nearest local camera beyond which rejectable particle systems aren't spawned.
+	static const float MaxParticleSystemDistance;
+
+	// The frame that NumParticleSystemSpawns is counting for.
+	mutable uint64 ParticleSystemSpawnFrame = 0;
+
+	// The number of rejectable particle systems spawned on this vehicle in ParticleSystemSpawnFrame.
+	mutable int32 NumParticleSystemSpawns = 0;
+
 #pragma endregion Miscellaneous
 
 #pragma region TransientProperties
@@ -1468,6 +1528,16 @@ private:
 	UPROPERTY(Transient)
 		TArray<UAudioComponent*> PistonEngineAudio;
 
+	// Is the engine audio currently virtualized?
+	bool EngineAudioVirtualized = false;
+
+	// Bit mask of the engine audio components that were playing when the engine audio was virtualized, jet engine first.
+	uint32 VirtualizedEngineAudio = 0;
+
+	// The pools of particle system components for short-lived effects, keyed by template.
+	UPROPERTY(Transient)
+		TMap<UParticleSystem*, FParticleSystemPool> ParticleSystemPools;
+
 	// Audio component for the gear shift sound.
 	UPROPERTY(Transient)
 		UAudioComponent* GearShiftAudio = nullptr;
@@ -1563,6 +1633,7 @@ private:
 	friend class ADebugVehicleHUD;
 	friend class ADebugCatchupHUD;
 	friend class ADebugRaceCameraHUD;
+	friend class APlayGameMode;
 
 #pragma endregion FriendClasses
 
@@ -17,6 +17,9 @@
 #include "sound/soundcue.h"
 #include "vehicleaudio.generated.h"
 
+class ABaseVehicle;
+class UAudioComponent;
+
 #pragma region MinimalVehicle
 
 /**
@@ -128,4 +131,71 @@ public:
 		TArray<FVehicleAudioGear> Gears;
 };
 
+/**
+* Manager for the audio of all of the vehicles in a game, ranking them by how well
+* they can be heard to budget the voices between them. The one-shot sounds played on
+* the vehicles come from a pool of audio components, and the engine audio of the
+* vehicles that can't be heard is virtualized.
+***********************************************************************************/
+
+USTRUCT()
+struct FVehicleAudioManager
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+
+	// Update the audibility of the vehicles and virtualize the engine audio of those that can't be heard.
+	void Tick(UWorld* world, const TArray<ABaseVehicle*>& vehicles);
+
+	// Play a one-shot sound attached to a vehicle, returning nullptr if it didn't fit in the voice budget.
+	UAudioComponent* PlaySoundAttached(USoundBase* sound, const ABaseVehicle* vehicle, USceneComponent* attachTo, float volume = 1.0f, float pitch = 1.0f);
+
+	// Play a one-shot, non-spatialized sound for a vehicle, returning nullptr if it didn't fit in the voice budget.
+	UAudioComponent* PlaySound2D(USoundBase* sound, const ABaseVehicle* vehicle, float volume = 1.0f, float pitch = 1.0f);
+
+	// Get the audibility of a vehicle, between 0 and 1.
+	float GetAudibility(int32 vehicleIndex) const
+	{ return (vehicleIndex >= 0 && vehicleIndex < GRIP_MAX_PLAYERS) ? Audibility[vehicleIndex] : 0.0f; }
+
+	// Stop and release all of the pooled audio components.
+	void Empty();
+
+	// The maximum number of one-shot voices playing on vehicles at once.
+	static const int32 MaxVoices = 16;
+
+	// The maximum number of vehicles with engine audio playing at once.
+	static const int32 MaxEngineVehicles = 4;
+
+	// The distance from the nearest listener at which a vehicle can no longer be heard, in centimeters.
+	static const float MaxAudibleDistance;
+
+private:
+
+	// Get the locations of all of the local listeners.
+	static void GetListenerLocations(UWorld* world, TArray<FVector, TInlineAllocator<GRIP_MAX_LOCAL_PLAYERS>>& listeners);
+
+	// Compute the audibility of a vehicle, between 0 and 1, from the locations of the listeners.
+	static float ComputeAudibility(const ABaseVehicle* vehicle, const TArray<FVector, TInlineAllocator<GRIP_MAX_LOCAL_PLAYERS>>& listeners);
+
+	// Get the audibility of a vehicle, computing it if it wasn't updated last frame.
+	float GetCurrentAudibility(const ABaseVehicle* vehicle);
+
+	// Allocate a pooled audio component for a one-shot sound on a vehicle, returning nullptr if it didn't fit in the voice budget.
+	UAudioComponent* AllocateVoice(const ABaseVehicle* vehicle, USoundBase* sound);
+
+	// The pooled audio components for one-shot sounds.
+	UPROPERTY(Transient)
+		TArray<UAudioComponent*> Components;
+
+	// The audibility of each of the vehicles playing the pooled audio components.
+	TArray<float> ComponentAudibility;
+
+	// The audibility of each vehicle, indexed by vehicle index.
+	float Audibility[GRIP_MAX_PLAYERS] = { 0.0f };
+
+	// The frame on which the audibility of each vehicle was last computed, indexed by vehicle index.
+	uint64 AudibilityFrames[GRIP_MAX_PLAYERS] = { 0 };
+};
+
 #pragma endregion MinimalVehicle